@@ -0,0 +1,212 @@
+/*
+** ===========================================================================
+** File: bquant.c
+** Description: ReakoLite library block pattern quantizer
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Clamp the merge tolerance
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "quant.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_BQuant_BlkCost
+**
+** Description:
+**     Bytes the pixels of a block cost, reused pixels are free
+**
+** Input:
+**     apPix - block pixels
+**     nPixels - block pixel count
+**     pPal - standard palette or NULL if unknown
+**     nPalCols - standard palette size
+**
+** Output:
+**     none
+**
+** Return value:
+**     1 per standard palette pixel (index), RLS_PAL_BYTES per extended
+**     palette pixel; every pixel counts as standard if pPal is NULL
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_BQuant_BlkCost(RGB565_T** apPix, int nPixels,
+							  const uint16_t* pPal, int nPalCols)
+{
+	int nBkPix, nBkIdx, nIdx;
+	int nCost = 0;
+	for (nBkPix = 0; nBkPix < nPixels; nBkPix++)
+	{
+		for (nBkIdx = 0; nBkIdx < nBkPix; nBkIdx++)
+			if (*apPix[nBkIdx] == *apPix[nBkPix])
+				break;
+		if (nBkIdx < nBkPix)
+			continue;
+		if (!pPal)
+		{
+			nCost++;
+			continue;
+		}
+		for (nIdx = 0; nIdx < nPalCols; nIdx++)
+			if (pPal[nIdx] == *apPix[nBkPix])
+				break;
+		nCost += (nIdx < nPalCols) ? 1 : RLS_PAL_BYTES;
+	}
+	return nCost;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quantize_Blocks
+**
+** Description:
+**     Merges near-identical pixels inside every 2x2 block into an earlier
+**     pixel of the same block, so the encoder stores them as reused pixels
+**     (RLS_BKI_PU_USEB) for free. The first pixel of a block is never
+**     changed, so the standard palette built by the encoder is unaffected.
+**
+** Input:
+**     pImg - Image to quantize
+**     nWidth - Width of image
+**     nHeight - Height of image
+**     nStride - Row stride of image in pixels
+**     nTolerance - Per-channel tolerance in 8-bit scale (0 - off, at
+**                  most RLS_DIFF_TOL_MAX)
+**     pPal - Standard palette, NULL if not known yet
+**     nPalCols - Standard palette size
+**
+** Output:
+**     Quantized image
+**
+** Return value:
+**     Bytes saved (a lower bound when pPal is NULL)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Clamp the tolerance
+** 10/18/2026	agent			Row stride
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Quantize_Blocks(RGB565_T* pImg, int nWidth, int nHeight, int nStride,
+						int nTolerance, const uint16_t* pPal, int nPalCols)
+{
+	int nMaxDiff;
+	int nCols = RLS_CEIL(nWidth, 2);
+	int nRows = RLS_CEIL(nHeight, 2);
+	int nCurrCol, nCurrRow;
+	int nSaved = 0;
+
+	if (!pImg || nWidth <= 0 || nHeight <= 0 || nStride < nWidth
+	 || nTolerance <= 0)
+		return 0;
+	/* larger tolerances would overflow RLS_DIFF_MAX */
+	if (nTolerance > RLS_DIFF_TOL_MAX)
+		nTolerance = RLS_DIFF_TOL_MAX;
+	nMaxDiff = RLS_DIFF_MAX(nTolerance);
+
+	for (nCurrRow = 0; nCurrRow < nRows; nCurrRow++)
+	{
+		for (nCurrCol = 0; nCurrCol < nCols; nCurrCol++)
+		{
+			RGB565_T* apPix[2*2];
+			int nBkPix, nPixels = 0;
+			int nX = nCurrCol << 1, nY = nCurrRow << 1;
+
+			/* the pixels inside the image, in RLS_Common_ExtractBlock
+			   order; the block it extracts at an odd edge repeats these
+			   in place of the missing ones */
+			apPix[nPixels++] = &pImg[nStride * nY + nX];
+			if (nX + 1 < nWidth)
+				apPix[nPixels++] = &pImg[nStride * nY + nX + 1];
+			if (nY + 1 < nHeight)
+			{
+				apPix[nPixels++] = &pImg[nStride * (nY + 1) + nX];
+				if (nX + 1 < nWidth)
+					apPix[nPixels++] = &pImg[nStride * (nY + 1) + nX + 1];
+			}
+
+			nSaved += RLS_BQuant_BlkCost(apPix, nPixels, pPal, nPalCols);
+			for (nBkPix = 1; nBkPix < nPixels; nBkPix++)
+			{
+				int nBkIdx, nBest = -1, nBestDiff = nMaxDiff + 1;
+				for (nBkIdx = 0; nBkIdx < nBkPix; nBkIdx++)
+				{
+					int nDiff = RLS_Common_ColorDiff(*apPix[nBkPix],
+													 *apPix[nBkIdx]);
+					if (nDiff < nBestDiff)
+					{
+						nBestDiff = nDiff;
+						nBest = nBkIdx;
+					}
+				}
+				/* already reused (nBestDiff 0) or nothing close enough */
+				if (nBest < 0 || nBestDiff == 0)
+					continue;
+				*apPix[nBkPix] = *apPix[nBest];
+			}
+			nSaved -= RLS_BQuant_BlkCost(apPix, nPixels, pPal, nPalCols);
+		}
+	}
+	return nSaved;
+}
\ No newline at end of file
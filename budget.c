@@ -0,0 +1,422 @@
+/*
+** ===========================================================================
+** File: budget.c
+** Description: ReakoLite library size constrained encoder code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "budget.h"
+#include "decode.h"
+#include "encode.h"
+#include "thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_BUDGET_LEVELS \
+	(int)(sizeof(RLS_Budget_Levels) / sizeof(RLS_Budget_Levels[0]))
+#define RLS_BUDGET_SNAPS \
+	(int)(sizeof(RLS_Budget_Snaps) / sizeof(RLS_Budget_Snaps[0]))
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSBudgetJob_T RLSBudgetJob_T;
+
+typedef struct tagRLSBudgetJob_T
+{
+	const RLSBudget_T* ptBudget;
+	RLSQuantBlk_T** apStats; /* per frame, shared by every candidate */
+	RLSBudgetParm_T* atParms; /* candidates */
+	size_t* anSizes; /* per candidate, 0 - not encoded */
+	uint64_t* anErrors; /* per candidate, only if within the budget */
+	int nParms;
+	RLS_Mutex_T tMutex;
+	int nNext; /* next candidate for a worker */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+   Quantizer aggressiveness, mildest first: one color threshold, four color
+   fit error limit, block merge tolerance. Level 0 is the plain encoder,
+   the last level makes every block one color.
+*/
+static const int RLS_Budget_Levels[][3] =
+{
+	{RLS_QUANT_FLAT_TOL, RLS_QUANT_FIT_TOL, 0},
+	{20, 12, 4},
+	{24, 16, 8},
+	{32, 24, 12},
+	{40, 32, 16},
+	{48, 48, 24},
+	{64, 64, 32},
+	{96, 96, 48},
+	{128, 128, 64},
+	{UINT8_MAX, UINT8_MAX, 96}
+};
+
+/* snapping tolerances, at the last one every color is in the standard
+   palette */
+static const int RLS_Budget_Snaps[] =
+{
+	0, 4, 8, 16, 24, 32, 48, 64, 96, UINT8_MAX
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Budget_Eval
+**
+** Description:
+**     Encodes every frame with one candidate and measures the container
+**     size and, if it fits, the error against the source frames
+**
+** Input:
+**     ptJob - Search job
+**     nParm - Candidate
+**     pWork - Frame sized work buffer
+**     pDec - Frame sized decode buffer
+**     pEnc - 12 + RLS_ENCODE_BSIZE bytes for one encoded frame
+**
+** Output:
+**     Size and error of the candidate in the job
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Budget_Eval(RLSBudgetJob_T* ptJob, int nParm,
+							RGB565_T* pWork, RGB565_T* pDec, uint8_t* pEnc)
+{
+	const RLSBudget_T* ptBudget = ptJob->ptBudget;
+	const RLSBudgetParm_T* ptParm = &ptJob->atParms[nParm];
+	size_t nPixels = (size_t)ptBudget->nWidth * ptBudget->nHeight;
+	size_t nSize = ptBudget->nOverhead;
+	uint64_t nError = 0;
+	int nFrame;
+
+	for (nFrame = 0; nFrame < ptBudget->nFrames; nFrame++)
+	{
+		const RGB565_T* pSrc = ptBudget->apFrames[nFrame];
+		size_t nPix;
+		/* the frame goes after a header, so the decoder can check it */
+		uint32_t nFrameSize = RLS_Budget_EncodeFrame(pSrc,
+								ptJob->apStats[nFrame], pWork, pEnc + 12,
+								ptBudget->nWidth, ptBudget->nHeight,
+								ptBudget->bRPZA, ptBudget->bPal, ptParm);
+		if (!nFrameSize)
+			return;
+		nSize += nFrameSize;
+		/* past the budget only the size is of interest */
+		if (nSize > ptBudget->nMaxSize)
+			continue;
+		RLS_Common_MakeInfo(pEnc, 1, ptBudget->nWidth, ptBudget->nHeight,
+							0, false);
+		if (!RLS_Decode(pEnc, 12 + nFrameSize, 0, pDec, ptBudget->nWidth))
+			return;
+		for (nPix = 0; nPix < nPixels; nPix++)
+			nError += RLS_Common_ColorDiff(pSrc[nPix], pDec[nPix]);
+	}
+	ptJob->anErrors[nParm] = nError;
+	ptJob->anSizes[nParm] = nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Budget_Worker
+**
+** Description:
+**     Evaluates candidates until none are left
+**
+** Input:
+**     pArg - Pointer to the search job
+**
+** Output:
+**     Sizes and errors in the job
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Budget_Worker(void* pArg)
+{
+	RLSBudgetJob_T* ptJob = *(RLSBudgetJob_T**)pArg;
+	const RLSBudget_T* ptBudget = ptJob->ptBudget;
+	size_t nPixels = (size_t)ptBudget->nWidth * ptBudget->nHeight;
+	RGB565_T* pWork = (RGB565_T*)malloc(nPixels * sizeof(RGB565_T));
+	RGB565_T* pDec = (RGB565_T*)malloc(nPixels * sizeof(RGB565_T));
+	uint8_t* pEnc = (uint8_t*)malloc(12 + RLS_ENCODE_BSIZE(ptBudget->nWidth,
+														   ptBudget->nHeight));
+
+	/* without buffers the other workers take over */
+	while (pWork && pDec && pEnc)
+	{
+		int nParm;
+		RLS_Mutex_Lock(&ptJob->tMutex);
+		nParm = ptJob->nNext++;
+		RLS_Mutex_Unlock(&ptJob->tMutex);
+		if (nParm >= ptJob->nParms)
+			break;
+		RLS_Budget_Eval(ptJob, nParm, pWork, pDec, pEnc);
+	}
+	free(pEnc);
+	free(pDec);
+	free(pWork);
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Budget_EncodeFrame
+**
+** Description:
+**     Quantizes and encodes a frame with explicit tolerances, the same
+**     steps the encoder takes with its default ones
+**
+** Input:
+**     pSrc - Source frame, left untouched
+**     pStats - RLS_Quantize_Analyze of the source frame, NULL to have it
+**              analyzed here
+**     pWork - Frame sized work buffer
+**     pOut - RLS_ENCODE_BSIZE bytes for the encoded frame
+**     nWidth - Width of frame
+**     nHeight - Height of frame
+**     bRPZA - Use RLS_Quantize_Apply
+**     bPal - Use RLS_Quantize_Palette
+**     ptParm - Tolerances
+**
+** Output:
+**     Encoded frame, quantized frame in pWork
+**
+** Return value:
+**     Encoded frame size/0 (failed)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Budget_EncodeFrame(const RGB565_T* pSrc,
+								const RLSQuantBlk_T* pStats, RGB565_T* pWork,
+								uint8_t* pOut, int nWidth, int nHeight,
+								bool bRPZA, bool bPal,
+								const RLSBudgetParm_T* ptParm)
+{
+	uint16_t awPal[RLS_SPAL_SIZE];
+	int nPalCols = 0;
+
+	if (!pSrc || !pWork || !pOut || !ptParm || nWidth <= 0 || nHeight <= 0)
+		return 0;
+	memcpy(pWork, pSrc, (size_t)nWidth * nHeight * sizeof(RGB565_T));
+	if (bRPZA)
+	{
+		RLSQuantBlk_T* pOwnStats = NULL;
+		if (!pStats)
+		{
+			pOwnStats = RLS_Quantize_Analyze(pSrc, nWidth, nHeight, nWidth);
+			if (!pOwnStats)
+				return 0;
+			pStats = pOwnStats;
+		}
+		RLS_Quantize_Apply(pStats, pWork, nWidth, nHeight, nWidth,
+						   ptParm->nFlatTol, ptParm->nFitTol);
+		free(pOwnStats);
+	}
+	if (bPal)
+		nPalCols = RLS_Quantize_Palette(pWork, nWidth, nHeight, nWidth,
+										awPal, RLS_SPAL_SIZE);
+	/* the encoder state is per thread, set all of it */
+	RLS_Encode_SetSPal(nPalCols ? awPal : NULL, nPalCols);
+	if (ptParm->nMergeTol > 0)
+		RLS_Quantize_Blocks(pWork, nWidth, nHeight, nWidth, ptParm->nMergeTol,
+							nPalCols ? awPal : NULL, nPalCols);
+	RLS_Encode_SetSnap(ptParm->nSnapTol);
+	return RLS_Encode(pWork, pOut, false, 0, nWidth, nHeight, nWidth);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Budget_Search
+**
+** Description:
+**     Finds the quantizer/snapping tolerances giving the best quality
+**     container within a size limit. Every combination of quantizer level
+**     and snapping tolerance is encoded, several at once; quality is the
+**     summed RLS_Common_ColorDiff of the decoded frames against the
+**     source. The quantizer statistics of every frame are collected once
+**     and shared by all candidates.
+**
+** Input:
+**     ptBudget - Frames and size limit
+**     nWorkers - Threads (1 - search on the calling thread)
+**     ptBest - Best tolerances
+**     pnSize - Container size they give
+**     pnError - Their error, may be NULL
+**
+** Output:
+**     Best tolerances, size and error; if nothing fits, the smallest
+**     container size reached in pnSize (0 - nothing could be encoded)
+**
+** Return value:
+**     true (found)/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Budget_Search(const RLSBudget_T* ptBudget, int nWorkers,
+					   RLSBudgetParm_T* ptBest, size_t* pnSize,
+					   uint64_t* pnError)
+{
+	RLSBudgetJob_T tJob;
+	RLSBudgetJob_T* aptJobs[RLS_THREAD_MAX];
+	int nParm, nFrame, nBest = -1;
+	size_t nSmallest = 0;
+	bool bOK;
+
+	*pnSize = 0;
+	if (!ptBudget || !ptBudget->apFrames || ptBudget->nFrames <= 0
+	 || ptBudget->nWidth <= 0 || ptBudget->nHeight <= 0 || !ptBest)
+		return false;
+	memset(&tJob, 0, sizeof(tJob));
+	tJob.ptBudget = ptBudget;
+	tJob.nParms = RLS_BUDGET_LEVELS * RLS_BUDGET_SNAPS;
+	tJob.apStats = (RLSQuantBlk_T**)calloc(ptBudget->nFrames,
+										   sizeof(RLSQuantBlk_T*));
+	tJob.atParms = (RLSBudgetParm_T*)malloc(tJob.nParms
+											* sizeof(RLSBudgetParm_T));
+	tJob.anSizes = (size_t*)calloc(tJob.nParms, sizeof(size_t));
+	tJob.anErrors = (uint64_t*)calloc(tJob.nParms, sizeof(uint64_t));
+	bOK = tJob.apStats && tJob.atParms && tJob.anSizes && tJob.anErrors;
+
+	for (nFrame = 0; bOK && ptBudget->bRPZA && nFrame < ptBudget->nFrames;
+		 nFrame++)
+	{
+		tJob.apStats[nFrame] = RLS_Quantize_Analyze(
+									ptBudget->apFrames[nFrame],
+									ptBudget->nWidth, ptBudget->nHeight,
+									ptBudget->nWidth);
+		bOK = tJob.apStats[nFrame] != NULL;
+	}
+	if (bOK && RLS_Mutex_Init(&tJob.tMutex))
+	{
+		/* mildest first, equal results go to the gentler settings */
+		for (nParm = 0; nParm < tJob.nParms; nParm++)
+		{
+			const int* pnLevel = RLS_Budget_Levels[nParm / RLS_BUDGET_SNAPS];
+			tJob.atParms[nParm].nFlatTol = pnLevel[0];
+			tJob.atParms[nParm].nFitTol = pnLevel[1];
+			tJob.atParms[nParm].nMergeTol = pnLevel[2];
+			tJob.atParms[nParm].nSnapTol =
+				RLS_Budget_Snaps[nParm % RLS_BUDGET_SNAPS];
+		}
+		if (nWorkers > tJob.nParms)
+			nWorkers = tJob.nParms;
+		if (nWorkers > RLS_THREAD_MAX)
+			nWorkers = RLS_THREAD_MAX;
+		if (nWorkers < 1)
+			nWorkers = 1;
+		for (nParm = 0; nParm < nWorkers; nParm++)
+			aptJobs[nParm] = &tJob;
+		RLS_Thread_Run(RLS_Budget_Worker, aptJobs, sizeof(aptJobs[0]),
+					   nWorkers);
+		RLS_Mutex_Destroy(&tJob.tMutex);
+	}
+
+	for (nParm = 0; bOK && nParm < tJob.nParms; nParm++)
+	{
+		size_t nSize = tJob.anSizes[nParm];
+		if (!nSize)
+			continue;
+		if (!nSmallest || nSize < nSmallest)
+			nSmallest = nSize;
+		if (nSize > ptBudget->nMaxSize)
+			continue;
+		if (nBest < 0 || tJob.anErrors[nParm] < tJob.anErrors[nBest]
+		 || (tJob.anErrors[nParm] == tJob.anErrors[nBest]
+		  && nSize < tJob.anSizes[nBest]))
+			nBest = nParm;
+	}
+	if (nBest >= 0)
+	{
+		*ptBest = tJob.atParms[nBest];
+		*pnSize = tJob.anSizes[nBest];
+		if (pnError)
+			*pnError = tJob.anErrors[nBest];
+	}
+	else
+		*pnSize = nSmallest;
+
+	for (nFrame = 0; tJob.apStats && nFrame < ptBudget->nFrames; nFrame++)
+		free(tJob.apStats[nFrame]);
+	free(tJob.anErrors);
+	free(tJob.anSizes);
+	free(tJob.atParms);
+	free(tJob.apStats);
+	return nBest >= 0;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+** ===========================================================================
+** File: budget.h
+** Description: ReakoLite library size constrained encoder header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_BUDGET_H
+#define RLS_BUDGET_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+#include "quant.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSBudgetParm_T RLSBudgetParm_T;
+typedef struct tagRLSBudget_T RLSBudget_T;
+
+/* quantizer/snapping settings of one encode */
+typedef struct tagRLSBudgetParm_T
+{
+	int nFlatTol; /* RLS_Quantize_Apply */
+	int nFitTol;
+	int nMergeTol; /* RLS_Quantize_Blocks (0 - off) */
+	int nSnapTol; /* RLS_Encode_SetSnap (0 - off) */
+};
+
+typedef struct tagRLSBudget_T
+{
+	RGB565_T** apFrames; /* source frames, left untouched */
+	int nFrames;
+	int nWidth;
+	int nHeight;
+	bool bRPZA; /* RLS_Quantize_Apply is used */
+	bool bPal; /* RLS_Quantize_Palette is used */
+	size_t nOverhead; /* container bytes besides the frames */
+	size_t nMaxSize; /* container size limit */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern uint32_t RLS_Budget_EncodeFrame(const RGB565_T* pSrc,
+									   const RLSQuantBlk_T* pStats,
+									   RGB565_T* pWork, uint8_t* pOut,
+									   int nWidth, int nHeight, bool bRPZA,
+									   bool bPal,
+									   const RLSBudgetParm_T* ptParm);
+extern bool RLS_Budget_Search(const RLSBudget_T* ptBudget, int nWorkers,
+							  RLSBudgetParm_T* ptBest, size_t* pnSize,
+							  uint64_t* pnError);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_BUDGET_H
\ No newline at end of file
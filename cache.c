@@ -0,0 +1,694 @@
+/*
+** ===========================================================================
+** File: cache.c
+** Description: ReakoLite library decoded frame cache code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "cache.h"
+#include "common.h"
+#include "decode.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_CACHE_BUCKETS 64 /* initial bucket count */
+
+#define RLS_CACHE_FNV_BASIS 0xCBF29CE484222325ULL
+#define RLS_CACHE_FNV_PRIME 0x00000100000001B3ULL
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Bucket
+**
+** Description:
+**     Gets the bucket of a frame
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Container key
+**     nFrame - Frame
+**
+** Output:
+**     none
+**
+** Return value:
+**     Bucket
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint32_t RLS_Cache_Bucket(const RLSCache_T* ptCache, uint64_t nKey,
+								 int nFrame)
+{
+	/* keys are often pointers, so the low bits need mixing in */
+	uint64_t nHash = (nKey + (uint64_t)nFrame * 0x9E3779B97F4A7C15ULL)
+				   * 0xBF58476D1CE4E5B9ULL;
+	nHash ^= nHash >> 31;
+	return (uint32_t)nHash & (ptCache->nBuckets - 1);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Remove
+**
+** Description:
+**     Removes an entry from its bucket and the LRU list and frees it
+**
+** Input:
+**     ptCache - Cache
+**     ptEnt - Entry
+**
+** Output:
+**     Cache without the entry
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Cache_Remove(RLSCache_T* ptCache, RLSCacheEnt_T* ptEnt)
+{
+	RLSCacheEnt_T** pptLink = &ptCache->aptBuckets[RLS_Cache_Bucket(ptCache,
+								ptEnt->nKey, ptEnt->nFrame)];
+	while (*pptLink != ptEnt)
+		pptLink = &(*pptLink)->ptNext;
+	*pptLink = ptEnt->ptNext;
+	if (ptEnt->ptNewer)
+		ptEnt->ptNewer->ptOlder = ptEnt->ptOlder;
+	else
+		ptCache->ptNewest = ptEnt->ptOlder;
+	if (ptEnt->ptOlder)
+		ptEnt->ptOlder->ptNewer = ptEnt->ptNewer;
+	else
+		ptCache->ptOldest = ptEnt->ptNewer;
+	ptCache->nBytes -= ptEnt->nBytes;
+	ptCache->nEntries--;
+	free(ptEnt);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_MakeNewest
+**
+** Description:
+**     Moves an entry to the newest end of the LRU list
+**
+** Input:
+**     ptCache - Cache
+**     ptEnt - Entry, linked or not
+**
+** Output:
+**     LRU list
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Cache_MakeNewest(RLSCache_T* ptCache, RLSCacheEnt_T* ptEnt)
+{
+	if (ptCache->ptNewest == ptEnt)
+		return;
+	if (ptEnt->ptNewer) /* linked: take it out first */
+	{
+		ptEnt->ptNewer->ptOlder = ptEnt->ptOlder;
+		if (ptEnt->ptOlder)
+			ptEnt->ptOlder->ptNewer = ptEnt->ptNewer;
+		else
+			ptCache->ptOldest = ptEnt->ptNewer;
+	}
+	ptEnt->ptNewer = NULL;
+	ptEnt->ptOlder = ptCache->ptNewest;
+	if (ptCache->ptNewest)
+		ptCache->ptNewest->ptNewer = ptEnt;
+	else
+		ptCache->ptOldest = ptEnt;
+	ptCache->ptNewest = ptEnt;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Grow
+**
+** Description:
+**     Doubles the bucket count once there are more entries than buckets
+**
+** Input:
+**     ptCache - Cache
+**
+** Output:
+**     Rehashed cache, unchanged if out of memory
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Cache_Grow(RLSCache_T* ptCache)
+{
+	RLSCacheEnt_T** aptOld = ptCache->aptBuckets;
+	uint32_t nOld = ptCache->nBuckets, nBucket;
+
+	if ((uint32_t)ptCache->nEntries <= nOld || nOld > UINT32_MAX / 2)
+		return;
+	ptCache->aptBuckets = (RLSCacheEnt_T**)calloc(nOld * 2,
+												  sizeof(RLSCacheEnt_T*));
+	if (!ptCache->aptBuckets)
+	{
+		ptCache->aptBuckets = aptOld;
+		return;
+	}
+	ptCache->nBuckets = nOld * 2;
+	for (nBucket = 0; nBucket < nOld; nBucket++)
+	{
+		RLSCacheEnt_T* ptEnt = aptOld[nBucket];
+		while (ptEnt)
+		{
+			RLSCacheEnt_T* ptNext = ptEnt->ptNext;
+			RLSCacheEnt_T** pptHead = &ptCache->aptBuckets[RLS_Cache_Bucket(
+										ptCache, ptEnt->nKey, ptEnt->nFrame)];
+			ptEnt->ptNext = *pptHead;
+			*pptHead = ptEnt;
+			ptEnt = ptNext;
+		}
+	}
+	free(aptOld);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Find
+**
+** Description:
+**     Looks up a frame, without touching the counters or the LRU order
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Container key
+**     nFrame - Frame
+**
+** Output:
+**     none
+**
+** Return value:
+**     Entry/NULL (not cached)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static RLSCacheEnt_T* RLS_Cache_Find(const RLSCache_T* ptCache,
+									 uint64_t nKey, int nFrame)
+{
+	RLSCacheEnt_T* ptEnt;
+	for (ptEnt = ptCache->aptBuckets[RLS_Cache_Bucket(ptCache, nKey, nFrame)];
+		 ptEnt; ptEnt = ptEnt->ptNext)
+	{
+		if (ptEnt->nKey == nKey && ptEnt->nFrame == nFrame)
+			return ptEnt;
+	}
+	return NULL;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Draw
+**
+** Description:
+**     Decodes frames in order over a buffer that holds the frame before
+**     the first one (zeroes before frame 0), as alpha blocks keep the
+**     pixels below them
+**
+** Input:
+**     pIn - Container
+**     nSize - Container size, 0 if unknown
+**     nFrom - First frame to decode
+**     nFrame - Last frame to decode
+**     pOut - Frame nFrom - 1
+**     nWidth - Image width
+**
+** Output:
+**     pOut - Frame nFrame
+**
+** Return value:
+**     true/false (decode failed)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Cache_Draw(uint8_t* pIn, size_t nSize, int nFrom, int nFrame,
+						   uint16_t* pOut, int nWidth)
+{
+	for (; nFrom <= nFrame; nFrom++)
+	{
+		if (!RLS_Decode(pIn, nSize, nFrom, pOut, nWidth))
+			return false;
+	}
+	return true;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Init
+**
+** Description:
+**     Sets up an empty cache. A cache is not thread-safe, use one per
+**     thread or lock around it.
+**
+** Input:
+**     ptCache - Cache
+**     nMaxBytes - Byte budget, pixels and bookkeeping
+**
+** Output:
+**     Empty cache
+**
+** Return value:
+**     true/false (out of memory)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Cache_Init(RLSCache_T* ptCache, size_t nMaxBytes)
+{
+	if (!ptCache)
+		return false;
+	memset(ptCache, 0, sizeof(RLSCache_T));
+	ptCache->aptBuckets = (RLSCacheEnt_T**)calloc(RLS_CACHE_BUCKETS,
+												  sizeof(RLSCacheEnt_T*));
+	if (!ptCache->aptBuckets)
+		return false;
+	ptCache->nBuckets = RLS_CACHE_BUCKETS;
+	ptCache->nMaxBytes = nMaxBytes;
+	ptCache->nScratchFrame = -1;
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Free
+**
+** Description:
+**     Frees a cache and every frame in it
+**
+** Input:
+**     ptCache - Cache
+**
+** Output:
+**     Cleared cache
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cache_Free(RLSCache_T* ptCache)
+{
+	if (!ptCache || !ptCache->aptBuckets)
+		return;
+	RLS_Cache_Clear(ptCache);
+	free(ptCache->aptBuckets);
+	free(ptCache->pScratch);
+	memset(ptCache, 0, sizeof(RLSCache_T));
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Hash
+**
+** Description:
+**     Hashes a container (64-bit FNV-1a), a key that stays the same when
+**     the container is loaded again at another address. Compute it once
+**     per load, not per frame.
+**
+** Input:
+**     pData - Container
+**     nSize - Container size
+**
+** Output:
+**     none
+**
+** Return value:
+**     Key for RLS_Cache_DecodeKey
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint64_t RLS_Cache_Hash(const uint8_t* pData, size_t nSize)
+{
+	uint64_t nHash = RLS_CACHE_FNV_BASIS;
+	size_t nPos;
+	for (nPos = 0; nPos < nSize; nPos++)
+	{
+		nHash ^= pData[nPos];
+		nHash *= RLS_CACHE_FNV_PRIME;
+	}
+	return nHash;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_DecodeKey
+**
+** Description:
+**     Gets a decoded frame from the cache, decoding it on a miss the way
+**     RLS_Export_PNGs does: in order from frame 0 over zeroes, or from the
+**     closest cached frame before it. A cold random access decodes every
+**     frame before it. Least recently used frames are evicted to stay in
+**     the budget; frames larger than the whole budget are decoded into a
+**     scratch buffer and not kept.
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Container key (RLS_Cache_Hash or any unique number)
+**     pIn - Container
+**     nSize - Container size, 0 if unknown
+**     nFrame - Frame
+**
+** Output:
+**     Hit/miss counters
+**
+** Return value:
+**     Frame (width * height RGB565 pixels), valid until the next call on
+**     the cache/NULL (failed)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+const uint16_t* RLS_Cache_DecodeKey(RLSCache_T* ptCache, uint64_t nKey,
+									uint8_t* pIn, size_t nSize, int nFrame)
+{
+	RLSCacheEnt_T *ptEnt, *ptBase = NULL;
+	uint32_t nBucket;
+	int nFrames = 0, nWidth = 0, nHeight = 0, nBase;
+	size_t nPixBytes;
+
+	if (!ptCache || !ptCache->aptBuckets || !pIn || nFrame < 0)
+		return NULL;
+	ptEnt = RLS_Cache_Find(ptCache, nKey, nFrame);
+	if (ptEnt)
+	{
+		ptCache->nHits++;
+		RLS_Cache_MakeNewest(ptCache, ptEnt);
+		return (const uint16_t*)(ptEnt + 1);
+	}
+
+	ptCache->nMisses++;
+	if (nSize && nSize < 12)
+		return NULL;
+	RLS_Common_GetInfo(pIn, &nFrames, &nWidth, &nHeight, NULL);
+	if (nFrame >= nFrames || nWidth <= 0 || nHeight <= 0)
+		return NULL;
+	nPixBytes = (size_t)nWidth * nHeight * sizeof(uint16_t);
+	if (sizeof(RLSCacheEnt_T) + nPixBytes > ptCache->nMaxBytes)
+	{
+		/* none of the frames fit, the scratch buffer goes on from the
+		   frame it holds when it can */
+		if (ptCache->nScratch < nPixBytes)
+		{
+			uint16_t* pGrown = (uint16_t*)realloc(ptCache->pScratch,
+												  nPixBytes);
+			if (!pGrown)
+				return NULL;
+			ptCache->pScratch = pGrown;
+			ptCache->nScratch = nPixBytes;
+			ptCache->nScratchFrame = -1;
+		}
+		if (ptCache->nScratchKey != nKey || ptCache->nScratchFrame > nFrame)
+			ptCache->nScratchFrame = -1;
+		if (ptCache->nScratchFrame < 0)
+			memset(ptCache->pScratch, 0, nPixBytes);
+		nBase = ptCache->nScratchFrame;
+		ptCache->nScratchKey = nKey;
+		ptCache->nScratchFrame = -1;
+		if (!RLS_Cache_Draw(pIn, nSize, nBase + 1, nFrame, ptCache->pScratch,
+							nWidth))
+			return NULL;
+		ptCache->nScratchFrame = nFrame;
+		return ptCache->pScratch;
+	}
+
+	while (ptCache->ptOldest
+		&& ptCache->nBytes + sizeof(RLSCacheEnt_T) + nPixBytes
+		   > ptCache->nMaxBytes)
+	{
+		RLS_Cache_Remove(ptCache, ptCache->ptOldest);
+		ptCache->nEvictions++;
+	}
+	ptEnt = (RLSCacheEnt_T*)malloc(sizeof(RLSCacheEnt_T) + nPixBytes);
+	if (!ptEnt)
+		return NULL;
+	/* start from the closest cached frame before this one */
+	for (nBase = nFrame - 1; nBase >= 0 && !ptBase; nBase--)
+		ptBase = RLS_Cache_Find(ptCache, nKey, nBase);
+	if (ptBase)
+		memcpy(ptEnt + 1, ptBase + 1, nPixBytes);
+	else
+		memset(ptEnt + 1, 0, nPixBytes);
+	if (!RLS_Cache_Draw(pIn, nSize, ptBase ? ptBase->nFrame + 1 : 0, nFrame,
+						(uint16_t*)(ptEnt + 1), nWidth))
+	{
+		free(ptEnt);
+		return NULL;
+	}
+	nBucket = RLS_Cache_Bucket(ptCache, nKey, nFrame);
+	ptEnt->nKey = nKey;
+	ptEnt->nFrame = nFrame;
+	ptEnt->nBytes = sizeof(RLSCacheEnt_T) + nPixBytes;
+	ptEnt->ptNewer = ptEnt->ptOlder = NULL;
+	ptEnt->ptNext = ptCache->aptBuckets[nBucket];
+	ptCache->aptBuckets[nBucket] = ptEnt;
+	RLS_Cache_MakeNewest(ptCache, ptEnt);
+	ptCache->nBytes += ptEnt->nBytes;
+	ptCache->nEntries++;
+	RLS_Cache_Grow(ptCache);
+	return (const uint16_t*)(ptEnt + 1);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Decode
+**
+** Description:
+**     RLS_Cache_DecodeKey keyed by the container address. Drop the frames
+**     of a container (RLS_Cache_Drop) before its memory is reused.
+**
+** Input:
+**     ptCache - Cache
+**     pIn - Container
+**     nSize - Container size, 0 if unknown
+**     nFrame - Frame
+**
+** Output:
+**     Hit/miss counters
+**
+** Return value:
+**     See RLS_Cache_DecodeKey
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+const uint16_t* RLS_Cache_Decode(RLSCache_T* ptCache, uint8_t* pIn,
+								 size_t nSize, int nFrame)
+{
+	return RLS_Cache_DecodeKey(ptCache, (uint64_t)(uintptr_t)pIn, pIn, nSize,
+							   nFrame);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Drop
+**
+** Description:
+**     Drops every frame of a container
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Container key, (uintptr_t) of the container for
+**            RLS_Cache_Decode
+**
+** Output:
+**     Cache without the frames
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cache_Drop(RLSCache_T* ptCache, uint64_t nKey)
+{
+	RLSCacheEnt_T* ptEnt;
+	if (!ptCache)
+		return;
+	ptEnt = ptCache->ptOldest;
+	while (ptEnt)
+	{
+		RLSCacheEnt_T* ptNewer = ptEnt->ptNewer;
+		if (ptEnt->nKey == nKey)
+			RLS_Cache_Remove(ptCache, ptEnt);
+		ptEnt = ptNewer;
+	}
+	if (ptCache->nScratchKey == nKey)
+		ptCache->nScratchFrame = -1;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cache_Clear
+**
+** Description:
+**     Drops every frame, the counters are kept
+**
+** Input:
+**     ptCache - Cache
+**
+** Output:
+**     Empty cache
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cache_Clear(RLSCache_T* ptCache)
+{
+	if (!ptCache)
+		return;
+	while (ptCache->ptOldest)
+		RLS_Cache_Remove(ptCache, ptCache->ptOldest);
+	ptCache->nScratchFrame = -1;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+** ===========================================================================
+** File: cache.h
+** Description: ReakoLite library decoded frame cache header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode over the previous frame
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_CACHE_H
+#define RLS_CACHE_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSCacheEnt_T RLSCacheEnt_T;
+typedef struct tagRLSCache_T RLSCache_T;
+
+/* one decoded frame, the pixels follow the entry */
+typedef struct tagRLSCacheEnt_T
+{
+	uint64_t nKey; /* container */
+	int nFrame;
+	size_t nBytes; /* entry and pixels */
+	RLSCacheEnt_T* ptNext; /* same bucket */
+	RLSCacheEnt_T* ptNewer; /* LRU list */
+	RLSCacheEnt_T* ptOlder;
+};
+
+/* decoded frames under a byte budget, least recently used go first */
+typedef struct tagRLSCache_T
+{
+	size_t nMaxBytes;
+	size_t nBytes;
+	RLSCacheEnt_T** aptBuckets;
+	uint32_t nBuckets; /* power of two */
+	int nEntries;
+	RLSCacheEnt_T* ptNewest;
+	RLSCacheEnt_T* ptOldest;
+	uint16_t* pScratch; /* frames larger than the budget */
+	size_t nScratch;
+	uint64_t nScratchKey;
+	int nScratchFrame; /* frame in the scratch buffer, -1 - none */
+	uint64_t nHits;
+	uint64_t nMisses;
+	uint64_t nEvictions;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_Cache_Init(RLSCache_T* ptCache, size_t nMaxBytes);
+extern void RLS_Cache_Free(RLSCache_T* ptCache);
+extern uint64_t RLS_Cache_Hash(const uint8_t* pData, size_t nSize);
+extern const uint16_t* RLS_Cache_DecodeKey(RLSCache_T* ptCache,
+										   uint64_t nKey, uint8_t* pIn,
+										   size_t nSize, int nFrame);
+extern const uint16_t* RLS_Cache_Decode(RLSCache_T* ptCache, uint8_t* pIn,
+										size_t nSize, int nFrame);
+extern void RLS_Cache_Drop(RLSCache_T* ptCache, uint64_t nKey);
+extern void RLS_Cache_Clear(RLSCache_T* ptCache);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_CACHE_H
\ No newline at end of file
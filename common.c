@@ -6,6 +6,13 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check frame index entries against the frames
+** 10/18/2026	agent			Frame size check
+** 10/18/2026	agent			Odd widths and heights
+** 10/18/2026	agent			Per-thread codec state, container size
+** 10/18/2026	agent			Frame index chunk
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Perceptual color difference
 ** 08/26/2024	raulmrio28-git	Add header creation
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
@@ -19,6 +26,7 @@
 
 #include "common.h"
 #include <stdio.h>
+#include <memory.h>
 
 /*
 **----------------------------------------------------------------------------
@@ -38,11 +46,11 @@
 **----------------------------------------------------------------------------
 */
 
-uint16_t RLS_Common_StdPal[RLS_SPAL_SIZE];
-uint16_t RLS_Common_ExtPal[RLS_EPAL_SIZE];
+RLS_TLS uint16_t RLS_Common_StdPal[RLS_SPAL_SIZE];
+RLS_TLS uint16_t RLS_Common_ExtPal[RLS_EPAL_SIZE];
 
-uint16_t RLS_Common_Block[2*2];
-uint32_t RLS_Common_ExtPal_CIdx;
+RLS_TLS uint16_t RLS_Common_Block[2*2];
+RLS_TLS uint32_t RLS_Common_ExtPal_CIdx;
 
 /* 
    Blocks legend: P - pal idx, I - reused pixel idx in blk
@@ -245,6 +253,7 @@ bool RLS_Common_MakeInfo(uint8_t* pData, int nFrames, int nWidth, int nHeight,
 **     pImg - Source image
 **     nWidth - Image width
 **     nHeight - Image height
+**     nStride - Image row stride in pixels (at least nWidth)
 **     nX - X position
 **     nY - Y position
 **
@@ -257,33 +266,35 @@ bool RLS_Common_MakeInfo(uint8_t* pData, int nFrames, int nWidth, int nHeight,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Odd widths and heights
+** 10/18/2026	agent			Row stride
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
-bool RLS_Common_ExtractBlock(uint16_t* pImg, int nWidth, int nHeight, int nX,
-							 int nY)
+bool RLS_Common_ExtractBlock(uint16_t* pImg, int nWidth, int nHeight,
+							 int nStride, int nX, int nY)
 {
-	if (!pImg || nX >= (nWidth >> 1) || nY >= (nHeight >> 1))
+	bool bLastCol, bLastRow;
+	if (!pImg || nStride < nWidth || nX >= RLS_CEIL(nWidth, 2)
+	 || nY >= RLS_CEIL(nHeight, 2))
 		return false;
-	RLS_Common_Block[0] = pImg[nWidth * (nY << 1) + (nX << 1)];
-	if ((nWidth&1 && (nWidth+1) == (nX<<1))
-	 && (nHeight&1 && (nHeight+1) == (nY<<1)))
+	/* blocks past an odd edge repeat the pixels inside the image */
+	bLastCol = (nWidth&1) && (nX<<1) == nWidth-1;
+	bLastRow = (nHeight&1) && (nY<<1) == nHeight-1;
+	RLS_Common_Block[0] = pImg[nStride * (nY << 1) + (nX << 1)];
+	RLS_Common_Block[1] = bLastCol ? RLS_Common_Block[0]
+						: pImg[nStride * (nY<<1) + ((nX<<1) + 1)];
+	if (bLastRow)
 	{
-		RLS_Common_Block[1] = RLS_Common_Block[2]
-	  = RLS_Common_Block[3] = RLS_Common_Block[0];
-	}
-	else if (nWidth&1 && (nWidth+1) == (nX<<1))
-	{
-		RLS_Common_Block[1] = RLS_Common_Block[0];
-		RLS_Common_Block[2] = pImg[nWidth * ((nY<<1) + 1) + (nX<<1)];
-		RLS_Common_Block[3] = RLS_Common_Block[2];
+		RLS_Common_Block[2] = RLS_Common_Block[0];
+		RLS_Common_Block[3] = RLS_Common_Block[1];
 	}
 	else
 	{
-		RLS_Common_Block[1] = pImg[nWidth * (nY<<1) + ((nX<<1) + 1)];
-		RLS_Common_Block[2] = pImg[nWidth * ((nY<<1) + 1) + (nX<<1)];
-		RLS_Common_Block[3] = pImg[nWidth * ((nY<<1) + 1) + ((nX<<1) + 1)];
+		RLS_Common_Block[2] = pImg[nStride * ((nY<<1) + 1) + (nX<<1)];
+		RLS_Common_Block[3] = bLastCol ? RLS_Common_Block[2]
+							: pImg[nStride * ((nY<<1) + 1) + ((nX<<1) + 1)];
 	}
 
 	return true;
@@ -302,6 +313,7 @@ bool RLS_Common_ExtractBlock(uint16_t* pImg, int nWidth, int nHeight, int nX,
 **     pImg - Dest image
 **     nWidth - Image width
 **     nHeight - Image height
+**     nStride - Image row stride in pixels (at least nWidth)
 **     nX - X position
 **     nY - Y position
 **
@@ -314,25 +326,287 @@ bool RLS_Common_ExtractBlock(uint16_t* pImg, int nWidth, int nHeight, int nX,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Odd widths and heights
+** 10/18/2026	agent			Row stride
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
-bool RLS_Common_WriteBlock(uint16_t* pImg, int nWidth, int nHeight, int nX,
-						   int nY)
+bool RLS_Common_WriteBlock(uint16_t* pImg, int nWidth, int nHeight,
+						   int nStride, int nX, int nY)
 {
-	if (!pImg || nX >= (nWidth >> 1) || nY >= (nHeight >> 1))
+	bool bLastCol, bLastRow;
+	if (!pImg || nStride < nWidth || nX >= RLS_CEIL(nWidth, 2)
+	 || nY >= RLS_CEIL(nHeight, 2))
 		return false;
-	pImg[nWidth * (nY<<1) + (nX<<1)] = RLS_Common_Block[0];
-	if (nWidth&1 && (nWidth+1) == (nX<<1))
+	/* pixels past an odd edge are dropped */
+	bLastCol = (nWidth&1) && (nX<<1) == nWidth-1;
+	bLastRow = (nHeight&1) && (nY<<1) == nHeight-1;
+	pImg[nStride * (nY<<1) + (nX<<1)] = RLS_Common_Block[0];
+	if (!bLastCol)
+		pImg[nStride * (nY<<1) + (nX<<1)+1] = RLS_Common_Block[1];
+	if (!bLastRow)
 	{
-		pImg[nWidth * ((nY<<1)+1) + (nX<<1)] = RLS_Common_Block[2];
+		pImg[nStride * ((nY<<1)+1) + (nX<<1)] = RLS_Common_Block[2];
+		if (!bLastCol)
+			pImg[nStride * ((nY<<1)+1) + (nX<<1)+1] = RLS_Common_Block[3];
 	}
-	else
+
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Common_CheckFrame
+**
+** Description:
+**     Gets size of an encoded frame from its palette and data sizes, never
+**     reading past nSize
+**
+** Input:
+**     pFrame - Frame (standard palette, extended palette, blocks)
+**     nSize - Bytes available at pFrame
+**     nWidth - Frame width
+**     nHeight - Frame height
+**
+** Output:
+**     none
+**
+** Return value:
+**     Frame size/0 (not a valid frame of this size)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Split from RLS_Common_GetSize
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Common_CheckFrame(const uint8_t* pFrame, size_t nSize,
+							   int nWidth, int nHeight)
+{
+	size_t nBlocks = (size_t)RLS_CEIL(nWidth, 2) * RLS_CEIL(nHeight, 2);
+	size_t nOffset = 0;
+	uint32_t nExtSize, nDataSize;
+	if (!pFrame
+	 || nSize < RLS_SPAL_SIZE * RLS_PAL_BYTES + sizeof(uint32_t))
+		return 0;
+	nOffset += RLS_SPAL_SIZE * RLS_PAL_BYTES;
+	memcpy(&nExtSize, pFrame + nOffset, sizeof(uint32_t));
+	nOffset += sizeof(uint32_t);
+	/* every extended color belongs to a pixel */
+	if (nExtSize % RLS_PAL_BYTES
+	 || nExtSize > RLS_EPAL_SIZE * RLS_PAL_BYTES
+	 || nExtSize > nBlocks * 2*2 * RLS_PAL_BYTES
+	 || nSize - nOffset < nExtSize + sizeof(uint32_t))
+		return 0;
+	nOffset += nExtSize;
+	memcpy(&nDataSize, pFrame + nOffset, sizeof(uint32_t));
+	nOffset += sizeof(uint32_t);
+	/* a block is an info byte and up to 4 standard palette indices */
+	if (nDataSize < nBlocks || nDataSize > nBlocks * 5
+	 || nSize - nOffset < nDataSize)
+		return 0;
+	return (uint32_t)(nOffset + nDataSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Common_GetSize
+**
+** Description:
+**     Gets size of image container by walking the frame sizes, never
+**     reading past nSize. Cheap enough to validate arbitrary data.
+**
+** Input:
+**     pData - Source data
+**     nSize - Bytes available at pData
+**
+** Output:
+**     none
+**
+** Return value:
+**     Container size including the frame index/0 (not a valid container)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check every frame index entry
+** 10/18/2026	agent			Frame checks split to RLS_Common_CheckFrame
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+size_t RLS_Common_GetSize(const uint8_t* pData, size_t nSize)
+{
+	int nFrames = 0, nWidth = 0, nHeight = 0, nPixBytes = 0;
+	int nFrame;
+	size_t nOffset = 12;
+	uint32_t anOffsets[UINT8_MAX];
+	if (!pData || nSize < 12
+	 || RLS_Common_GetInfo((uint8_t*)pData, &nFrames, &nWidth, &nHeight,
+						   &nPixBytes) != 12
+	 || nFrames <= 0 || nWidth <= 0 || nHeight <= 0)
+		return 0;
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
 	{
-		pImg[nWidth * (nY<<1) + (nX<<1)+1] = RLS_Common_Block[1];
-		pImg[nWidth * ((nY<<1)+1) + (nX<<1)] = RLS_Common_Block[2];
-		pImg[nWidth * ((nY<<1)+1) + (nX<<1)+1] = RLS_Common_Block[3];
+		uint32_t nFrameSize = RLS_Common_CheckFrame(pData + nOffset,
+													nSize - nOffset, nWidth,
+													nHeight);
+		if (!nFrameSize)
+			return 0;
+		anOffsets[nFrame] = (uint32_t)nOffset;
+		nOffset += nFrameSize;
 	}
+	/* an index is only part of the container when every entry is right */
+	if (nSize - nOffset >= RLS_INDEX_SIZE(nFrames)
+	 && RLS_Common_GetFrameOffset(pData, nOffset + RLS_INDEX_SIZE(nFrames),
+								  0)
+	 && memcmp(pData + nOffset, anOffsets, nFrames * sizeof(uint32_t)) == 0)
+		nOffset += RLS_INDEX_SIZE(nFrames);
+	return nOffset;
+}
 
-	return true;
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Common_MakeIndex
+**
+** Description:
+**     Make frame index of image container
+**
+** Input:
+**     pData - Destination data, right after the last frame
+**     pnOffsets - Offset of every frame from the start of the container
+**     nFrames - Frame count
+**
+** Output:
+**     Written index
+**
+** Return value:
+**     Index size (RLS_INDEX_SIZE(nFrames))/0
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Common_MakeIndex(uint8_t* pData, const uint32_t* pnOffsets,
+						 int nFrames)
+{
+	uint32_t anFooter[2];
+	if (!pData || !pnOffsets || nFrames <= 0 || nFrames > UINT8_MAX)
+		return 0;
+	anFooter[0] = nFrames;
+	anFooter[1] = RLS_INDEX_MAGIC;
+	memcpy(pData, pnOffsets, nFrames * sizeof(uint32_t));
+	memcpy(pData + nFrames * sizeof(uint32_t), anFooter, sizeof(anFooter));
+	return (int)RLS_INDEX_SIZE(nFrames);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Common_GetFrameOffset
+**
+** Description:
+**     Looks a frame up in the frame index of image container. The entry
+**     must be followed by the next one (the index for the last frame) and
+**     the frame found must span exactly the bytes in between.
+**
+** Input:
+**     pData - Source data
+**     nSize - Source data size, 0 if unknown
+**     nFrame - Frame number
+**
+** Output:
+**     none
+**
+** Return value:
+**     Offset of the frame from pData/0 (no valid index, walk the frames)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check the entry against the next one
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Common_GetFrameOffset(const uint8_t* pData, size_t nSize,
+								   int nFrame)
+{
+	const RLSBaseHeader_T* ptHeader = (const RLSBaseHeader_T*)pData;
+	const uint8_t* pIndex;
+	uint32_t anFooter[2];
+	uint32_t nFirst, nOffset, nNext;
+	int nFrames = 0, nWidth = 0, nHeight = 0;
+	if (!pData || nSize < 12 + RLS_INDEX_SIZE(1) || nFrame < 0)
+		return 0;
+	memcpy(anFooter, pData + nSize - sizeof(anFooter), sizeof(anFooter));
+	if (anFooter[1] != RLS_INDEX_MAGIC || anFooter[0] != ptHeader->nFrames
+	 || (uint32_t)nFrame >= anFooter[0]
+	 || nSize - 12 < RLS_INDEX_SIZE(anFooter[0]))
+		return 0;
+	pIndex = pData + nSize - RLS_INDEX_SIZE(anFooter[0]);
+	memcpy(&nFirst, pIndex, sizeof(uint32_t));
+	memcpy(&nOffset, pIndex + nFrame * sizeof(uint32_t), sizeof(uint32_t));
+	nNext = (uint32_t)(pIndex - pData);
+	if ((uint32_t)nFrame + 1 < anFooter[0])
+		memcpy(&nNext, pIndex + (nFrame + 1) * sizeof(uint32_t),
+			   sizeof(uint32_t));
+	/* the first frame follows the header, a stray match in frame data
+	   hardly ever passes that */
+	if (nFirst != 12 || nOffset < 12 || nOffset >= nNext
+	 || nNext > (size_t)(pIndex - pData))
+		return 0;
+	/* the sizes of the frame found must lead to the next entry */
+	RLS_Common_GetInfo((uint8_t*)pData, &nFrames, &nWidth, &nHeight, NULL);
+	if (RLS_Common_CheckFrame(pData + nOffset, nNext - nOffset, nWidth,
+							  nHeight) != nNext - nOffset)
+		return 0;
+	return nOffset;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Common_ColorDiff
+**
+** Description:
+**     Perceptual (weighted squared) difference of two RGB565 colors in
+**     8-bit scale, compare against RLS_DIFF_MAX(tolerance)
+**
+** Input:
+**     wColorA - RGB565 color
+**     wColorB - RGB565 color
+**
+** Output:
+**     none
+**
+** Return value:
+**     Difference
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Common_ColorDiff(uint16_t wColorA, uint16_t wColorB)
+{
+	int nDR = ((wColorA >> 11) - (wColorB >> 11)) * 8;
+	int nDG = (((wColorA >> 5) & 0x3f) - ((wColorB >> 5) & 0x3f)) * 4;
+	int nDB = ((wColorA & 0x1f) - (wColorB & 0x1f)) * 8;
+	return RLS_DIFF_WR * nDR * nDR + RLS_DIFF_WG * nDG * nDG
+		 + RLS_DIFF_WB * nDB * nDB;
 }
\ No newline at end of file
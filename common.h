@@ -6,6 +6,12 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame size check
+** 10/18/2026	agent			Tolerance limit
+** 10/18/2026	agent			Per-thread codec state, container size
+** 10/18/2026	agent			Frame index chunk
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Perceptual color difference
 ** 08/26/2024	raulmrio28-git	Add header creation
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
@@ -20,6 +26,7 @@
 **----------------------------------------------------------------------------
 */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -50,6 +57,39 @@ extern "C" {
 
 #define RLS_CALC_SAVING(ts, os) RLS_CEIL(((ts-os)/2), RLS_SPAL_SIZE)
 
+/*
+   Frame index (optional, after the last frame): u32 offset of every frame
+   from the start of the container, u32 frame count, u32 RLS_INDEX_MAGIC.
+   Readers walking the frames stop before it, so older readers ignore it.
+*/
+
+#define RLS_INDEX_MAGIC 0x58444952 //stored as 'RIDX'
+#define RLS_INDEX_SIZE(f) (((f)+2)*sizeof(uint32_t))
+
+/*
+   Perceptual color difference (RLS_Common_ColorDiff): weighted squared
+   error in 8-bit scale, weights R:G:B = 3:4:2. A per-channel tolerance t
+   (0 to RLS_DIFF_TOL_MAX) corresponds to a difference of RLS_DIFF_MAX(t).
+*/
+
+#define RLS_DIFF_WR 3
+#define RLS_DIFF_WG 4
+#define RLS_DIFF_WB 2
+#define RLS_DIFF_MAX(t) ((RLS_DIFF_WR+RLS_DIFF_WG+RLS_DIFF_WB)*(t)*(t))
+#define RLS_DIFF_TOL_MAX UINT8_MAX
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+ || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RLS_HAVE_SSE2
+#endif
+
+/* codec state is per thread, so frames can be coded on several threads */
+#ifdef _MSC_VER
+#define RLS_TLS __declspec(thread)
+#else
+#define RLS_TLS __thread
+#endif
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -130,10 +170,10 @@ typedef enum tagRLS_PT_E
 */
 
 #ifdef RLS_EXTERN_VAR
-extern uint16_t RLS_Common_StdPal[RLS_SPAL_SIZE];
-extern uint16_t RLS_Common_ExtPal[RLS_EPAL_SIZE];
-extern uint16_t RLS_Common_Block[2*2];
-extern uint32_t RLS_Common_ExtPal_CIdx;
+extern RLS_TLS uint16_t RLS_Common_StdPal[RLS_SPAL_SIZE];
+extern RLS_TLS uint16_t RLS_Common_ExtPal[RLS_EPAL_SIZE];
+extern RLS_TLS uint16_t RLS_Common_Block[2*2];
+extern RLS_TLS uint32_t RLS_Common_ExtPal_CIdx;
 
 extern uint8_t RLS_Common_BkIdx[16];
 extern uint8_t RLS_Common_PalBits[16];
@@ -150,9 +190,17 @@ extern int RLS_Common_GetInfo(uint8_t* pData, int* pnFrames, int* pnWidth,
 extern bool RLS_Common_MakeInfo(uint8_t* pData, int nFrames, int nWidth,
 								int nHeight, int nSavings, bool bReserved);
 extern bool RLS_Common_ExtractBlock(uint16_t* pImg, int nWidth, int nHeight,
-									int nX, int nY);
+									int nStride, int nX, int nY);
 extern bool RLS_Common_WriteBlock(uint16_t* pImg, int nWidth, int nHeight,
-								  int nX, int nY);
+								  int nStride, int nX, int nY);
+extern uint32_t RLS_Common_CheckFrame(const uint8_t* pFrame, size_t nSize,
+									  int nWidth, int nHeight);
+extern size_t RLS_Common_GetSize(const uint8_t* pData, size_t nSize);
+extern int RLS_Common_MakeIndex(uint8_t* pData, const uint32_t* pnOffsets,
+								int nFrames);
+extern uint32_t RLS_Common_GetFrameOffset(const uint8_t* pData, size_t nSize,
+										  int nFrame);
+extern int RLS_Common_ColorDiff(uint16_t wColorA, uint16_t wColorB);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -6,6 +6,12 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Parallel PNG export for large images
+** 10/18/2026	agent			Indexed PNG export
+** 10/18/2026	agent			Streaming PNG export
+** 10/18/2026	agent			PNG export profiles and filter choice
+** 10/18/2026	agent			Streaming PNG import
+** 10/18/2026	agent			SIMD RGB565<->RGB888 kernels
 ** 08/26/2024	raulmrio28-git	PNG to RGB565
 ** 08/24/2024	raulmrio28-git	Initial version
 ** ===========================================================================
@@ -18,7 +24,23 @@
 */
 
 #include "convert.h"
+#include "ppng.h"
+#include "thread.h"
 #include "spng/spng.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) \
+ || defined(_M_IX86)
+#define RLS_CVT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define RLS_CVT_NEON
+#include <arm_neon.h>
+#endif
 
 /*
 **----------------------------------------------------------------------------
@@ -27,29 +49,939 @@
 */
 
 /*
-**----------------------------------------------------------------------------
-**  Type Definitions
-**----------------------------------------------------------------------------
+   Kernels built for instruction sets the compiler does not enable by
+   default are tagged with a target attribute (GCC/Clang); MSVC accepts the
+   intrinsics anywhere. They are only called after a CPUID check.
+*/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RLS_CVT_TARGET(x) __attribute__((target(x)))
+#else
+#define RLS_CVT_TARGET(x)
+#endif
+
+#define RLS_PNG_PAL_SIZE 256
+#define RLS_PNG_PAL_HASH 1024 /* power of 2, kept at most 1/4 full */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef void (*RLSCvt565to888Fn_T)(const RGB565_T* pSrc, RGB888_T* pDest,
+								   int nSize);
+typedef void (*RLSCvt888to565Fn_T)(const RGB888_T* pSrc, RGB565_T* pDest,
+								   int nSize);
+
+typedef struct tagRLSPNGPal_T RLSPNGPal_T;
+
+typedef struct tagRLSPNGPal_T
+{
+	int nCols;
+	int16_t anIdx[RLS_PNG_PAL_HASH]; /* -1 - free slot */
+	uint16_t awKey[RLS_PNG_PAL_HASH];
+	uint16_t awCol[RLS_PNG_PAL_SIZE];
+};
+
+typedef struct tagRLSPNGRowSrc_T RLSPNGRowSrc_T;
+
+typedef struct tagRLSPNGRowSrc_T
+{
+	RGB565_T* pImg;
+	int nWidth;
+	RLSPNGPal_T* ptPal; /* NULL - truecolor */
+	int nBits;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static RLSCvt565to888Fn_T RLS_Convert_pfn565to888 = NULL;
+static RLSCvt888to565Fn_T RLS_Convert_pfn888to565 = NULL;
+
+/* PNG export settings, see RLS_Convert_SetPNGProfile */
+static int RLS_Convert_PNGLevel = 9;
+static int RLS_Convert_PNGProfFilters = RLS_PNGF_ALL;
+static int RLS_Convert_PNGFilters = RLS_PNGF_PROFILE;
+static bool RLS_Convert_PNGIndexed = false;
+static int RLS_Convert_PNGThreads = 0; /* 0 - one per CPU */
+
+#ifdef RLS_CVT_X86
+/* 16 planar channel bytes -> 48 packed RGB888 bytes, [out vector][channel] */
+static const int8_t RLS_Convert_PackMask[3][3][16] =
+{
+	{
+		{0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5},
+		{-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1},
+		{-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1}
+	},
+	{
+		{-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1},
+		{5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10},
+		{-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1}
+	},
+	{
+		{-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1},
+		{-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1},
+		{10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15}
+	}
+};
+
+/* 48 packed RGB888 bytes -> 16 planar channel bytes, [channel][in vector] */
+static const int8_t RLS_Convert_UnpackMask[3][3][16] =
+{
+	{
+		{0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13}
+	},
+	{
+		{1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14}
+	},
+	{
+		{2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1},
+		{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15}
+	}
+};
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_565to888_C
+**
+** Description:
+**     Portable RGB565 to RGB888 pixel loop
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Moved out of RLS_Convert_565to888
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_565to888_C(const RGB565_T* pSrc, RGB888_T* pDest,
+								   int nSize)
+{
+	int nCurrSize;
+	for (nCurrSize = 0; nCurrSize < nSize; nCurrSize++)
+	{
+		pDest[nCurrSize].b = CVT_16BPP_EX_B(pSrc[nCurrSize]);
+		pDest[nCurrSize].g = CVT_16BPP_EX_G(pSrc[nCurrSize]);
+		pDest[nCurrSize].r = CVT_16BPP_EX_R(pSrc[nCurrSize]);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_888to565_C
+**
+** Description:
+**     Portable RGB888 to RGB565 pixel loop
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Moved out of RLS_Convert_888to565
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_888to565_C(const RGB888_T* pSrc, RGB565_T* pDest,
+								   int nSize)
+{
+	int nCurrSize;
+	for (nCurrSize = 0; nCurrSize < nSize; nCurrSize++)
+		pDest[nCurrSize] = ((pSrc[nCurrSize].b >> 3) << 11)
+					   | ((pSrc[nCurrSize].g >> 2) << 5)
+					   | (pSrc[nCurrSize].r >> 3);
+}
+
+#ifdef RLS_CVT_X86
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_565to888_SSSE3
+**
+** Description:
+**     SSSE3 RGB565 to RGB888, 16 pixels per step: channels are extracted
+**     with 16-bit shifts, narrowed to bytes and interleaved with pshufb
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RLS_CVT_TARGET("ssse3")
+static void RLS_Convert_565to888_SSSE3(const RGB565_T* pSrc,
+									   RGB888_T* pDest, int nSize)
+{
+	const __m128i tMask0 = _mm_set1_epi16(0xF8);
+	const __m128i tMask1 = _mm_set1_epi16(0xFC);
+	uint8_t* pOut = (uint8_t*)pDest;
+	int nCurrSize, nOut, nCh;
+
+	for (nCurrSize = 0; nCurrSize + 16 <= nSize; nCurrSize += 16)
+	{
+		__m128i tLo = _mm_loadu_si128((const __m128i*)&pSrc[nCurrSize]);
+		__m128i tHi = _mm_loadu_si128((const __m128i*)&pSrc[nCurrSize + 8]);
+		__m128i atCh[3];
+		atCh[0] = _mm_packus_epi16(
+					_mm_and_si128(_mm_srli_epi16(tLo, 8), tMask0),
+					_mm_and_si128(_mm_srli_epi16(tHi, 8), tMask0));
+		atCh[1] = _mm_packus_epi16(
+					_mm_and_si128(_mm_srli_epi16(tLo, 3), tMask1),
+					_mm_and_si128(_mm_srli_epi16(tHi, 3), tMask1));
+		atCh[2] = _mm_packus_epi16(
+					_mm_and_si128(_mm_slli_epi16(tLo, 3), tMask0),
+					_mm_and_si128(_mm_slli_epi16(tHi, 3), tMask0));
+		for (nOut = 0; nOut < 3; nOut++)
+		{
+			__m128i tPix = _mm_setzero_si128();
+			for (nCh = 0; nCh < 3; nCh++)
+				tPix = _mm_or_si128(tPix, _mm_shuffle_epi8(atCh[nCh],
+					   _mm_loadu_si128((const __m128i*)
+								RLS_Convert_PackMask[nOut][nCh])));
+			_mm_storeu_si128((__m128i*)&pOut[nCurrSize * 3 + nOut * 16],
+							 tPix);
+		}
+	}
+	RLS_Convert_565to888_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_888to565_SSSE3
+**
+** Description:
+**     SSSE3 RGB888 to RGB565, 16 pixels per step: pshufb splits the packed
+**     bytes into channel planes which are widened and merged
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RLS_CVT_TARGET("ssse3")
+static void RLS_Convert_888to565_SSSE3(const RGB888_T* pSrc,
+									   RGB565_T* pDest, int nSize)
+{
+	const __m128i tZero = _mm_setzero_si128();
+	const __m128i tMaskB = _mm_set1_epi16((short)0xF800);
+	const __m128i tMaskG = _mm_set1_epi16(0x07E0);
+	const uint8_t* pIn = (const uint8_t*)pSrc;
+	int nCurrSize, nIn, nCh;
+
+	for (nCurrSize = 0; nCurrSize + 16 <= nSize; nCurrSize += 16)
+	{
+		__m128i atIn[3], atCh[3];
+		__m128i tLo, tHi;
+		for (nIn = 0; nIn < 3; nIn++)
+			atIn[nIn] = _mm_loadu_si128((const __m128i*)
+										&pIn[nCurrSize * 3 + nIn * 16]);
+		for (nCh = 0; nCh < 3; nCh++)
+		{
+			atCh[nCh] = _mm_setzero_si128();
+			for (nIn = 0; nIn < 3; nIn++)
+				atCh[nCh] = _mm_or_si128(atCh[nCh],
+							_mm_shuffle_epi8(atIn[nIn], _mm_loadu_si128(
+								(const __m128i*)
+								RLS_Convert_UnpackMask[nCh][nIn])));
+		}
+		tLo = _mm_or_si128(_mm_or_si128(
+				_mm_and_si128(_mm_unpacklo_epi8(tZero, atCh[0]), tMaskB),
+				_mm_and_si128(_mm_slli_epi16(
+					_mm_unpacklo_epi8(atCh[1], tZero), 3), tMaskG)),
+				_mm_srli_epi16(_mm_unpacklo_epi8(atCh[2], tZero), 3));
+		tHi = _mm_or_si128(_mm_or_si128(
+				_mm_and_si128(_mm_unpackhi_epi8(tZero, atCh[0]), tMaskB),
+				_mm_and_si128(_mm_slli_epi16(
+					_mm_unpackhi_epi8(atCh[1], tZero), 3), tMaskG)),
+				_mm_srli_epi16(_mm_unpackhi_epi8(atCh[2], tZero), 3));
+		_mm_storeu_si128((__m128i*)&pDest[nCurrSize], tLo);
+		_mm_storeu_si128((__m128i*)&pDest[nCurrSize + 8], tHi);
+	}
+	RLS_Convert_888to565_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_565to888_AVX2
+**
+** Description:
+**     AVX2 RGB565 to RGB888, 8 pixels per step: each pixel is expanded to
+**     a 32-bit lane, compacted to 12 bytes per 128-bit half with pshufb
+**     and the halves joined with a cross-lane dword permute
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RLS_CVT_TARGET("avx2")
+static void RLS_Convert_565to888_AVX2(const RGB565_T* pSrc,
+									  RGB888_T* pDest, int nSize)
+{
+	const __m256i tMask0 = _mm256_set1_epi32(0x0000F8);
+	const __m256i tMask1 = _mm256_set1_epi32(0x00FC00);
+	const __m256i tMask2 = _mm256_set1_epi32(0xF80000);
+	const __m256i tPack = _mm256_setr_epi8(
+						0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+						0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m256i tJoin = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	uint8_t* pOut = (uint8_t*)pDest;
+	int nCurrSize;
+
+	for (nCurrSize = 0; nCurrSize + 8 <= nSize; nCurrSize += 8)
+	{
+		__m256i tPix = _mm256_cvtepu16_epi32(
+					_mm_loadu_si128((const __m128i*)&pSrc[nCurrSize]));
+		tPix = _mm256_or_si256(_mm256_or_si256(
+				_mm256_and_si256(_mm256_srli_epi32(tPix, 8), tMask0),
+				_mm256_and_si256(_mm256_slli_epi32(tPix, 5), tMask1)),
+				_mm256_and_si256(_mm256_slli_epi32(tPix, 19), tMask2));
+		tPix = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(tPix, tPack),
+										   tJoin);
+		_mm_storeu_si128((__m128i*)&pOut[nCurrSize * 3],
+						 _mm256_castsi256_si128(tPix));
+		_mm_storel_epi64((__m128i*)&pOut[nCurrSize * 3 + 16],
+						 _mm256_extracti128_si256(tPix, 1));
+	}
+	RLS_Convert_565to888_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_888to565_AVX2
+**
+** Description:
+**     AVX2 RGB888 to RGB565, 8 pixels per step: the 24 input bytes are
+**     spread over both 128-bit halves, expanded to one pixel per 32-bit
+**     lane with pshufb, merged and packed to 16 bits
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RLS_CVT_TARGET("avx2")
+static void RLS_Convert_888to565_AVX2(const RGB888_T* pSrc,
+									  RGB565_T* pDest, int nSize)
+{
+	const __m256i tSpread = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+	const __m256i tExpand = _mm256_setr_epi8(
+						0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+						0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m256i tMaskB = _mm256_set1_epi32(0xF8);
+	const __m256i tMaskG = _mm256_set1_epi32(0x07E0);
+	const __m256i tMaskR = _mm256_set1_epi32(0x001F);
+	const uint8_t* pIn = (const uint8_t*)pSrc;
+	int nCurrSize;
+
+	for (nCurrSize = 0; nCurrSize + 8 <= nSize; nCurrSize += 8)
+	{
+		__m256i tPix = _mm256_inserti128_si256(_mm256_castsi128_si256(
+					_mm_loadu_si128((const __m128i*)&pIn[nCurrSize * 3])),
+					_mm_loadl_epi64((const __m128i*)
+									&pIn[nCurrSize * 3 + 16]), 1);
+		tPix = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(tPix, tSpread),
+								   tExpand);
+		tPix = _mm256_or_si256(_mm256_or_si256(
+				_mm256_slli_epi32(_mm256_and_si256(tPix, tMaskB), 8),
+				_mm256_and_si256(_mm256_srli_epi32(tPix, 5), tMaskG)),
+				_mm256_and_si256(_mm256_srli_epi32(tPix, 19), tMaskR));
+		tPix = _mm256_permute4x64_epi64(_mm256_packus_epi32(tPix, tPix),
+										0x08);
+		_mm_storeu_si128((__m128i*)&pDest[nCurrSize],
+						 _mm256_castsi256_si128(tPix));
+	}
+	RLS_Convert_888to565_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_GetX86Caps
+**
+** Description:
+**     Checks SSSE3 and AVX2 support (AVX2 also needs OS saved YMM state)
+**
+** Input:
+**     pbSSSE3 - SSSE3 flag pointer
+**     pbAVX2 - AVX2 flag pointer
+**
+** Output:
+**     Support flags
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_GetX86Caps(bool* pbSSSE3, bool* pbAVX2)
+{
+#ifdef _MSC_VER
+	int anRegs[4];
+	__cpuid(anRegs, 0);
+	if (anRegs[0] < 1)
+	{
+		*pbSSSE3 = *pbAVX2 = false;
+		return;
+	}
+	__cpuid(anRegs, 1);
+	*pbSSSE3 = (anRegs[2] & (1 << 9)) != 0;
+	*pbAVX2 = false;
+	/* OSXSAVE + AVX, then XMM|YMM state enabled in XCR0 */
+	if ((anRegs[2] & (3 << 27)) == (3 << 27) && (_xgetbv(0) & 6) == 6)
+	{
+		__cpuid(anRegs, 0);
+		if (anRegs[0] >= 7)
+		{
+			__cpuidex(anRegs, 7, 0);
+			*pbAVX2 = (anRegs[1] & (1 << 5)) != 0;
+		}
+	}
+#else
+	__builtin_cpu_init();
+	*pbSSSE3 = __builtin_cpu_supports("ssse3") != 0;
+	*pbAVX2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+#ifdef RLS_CVT_NEON
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_565to888_NEON
+**
+** Description:
+**     NEON RGB565 to RGB888, 16 pixels per step with an interleaving store
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_565to888_NEON(const RGB565_T* pSrc,
+									  RGB888_T* pDest, int nSize)
+{
+	const uint8x16_t tMask0 = vdupq_n_u8(0xF8);
+	const uint8x16_t tMask1 = vdupq_n_u8(0xFC);
+	uint8_t* pOut = (uint8_t*)pDest;
+	int nCurrSize;
+
+	for (nCurrSize = 0; nCurrSize + 16 <= nSize; nCurrSize += 16)
+	{
+		uint16x8_t tLo = vld1q_u16(&pSrc[nCurrSize]);
+		uint16x8_t tHi = vld1q_u16(&pSrc[nCurrSize + 8]);
+		uint8x16x3_t tPix;
+		tPix.val[0] = vandq_u8(vcombine_u8(vshrn_n_u16(tLo, 8),
+										   vshrn_n_u16(tHi, 8)), tMask0);
+		tPix.val[1] = vandq_u8(vcombine_u8(vshrn_n_u16(tLo, 3),
+										   vshrn_n_u16(tHi, 3)), tMask1);
+		tPix.val[2] = vandq_u8(vcombine_u8(vmovn_u16(vshlq_n_u16(tLo, 3)),
+										   vmovn_u16(vshlq_n_u16(tHi, 3))),
+							   tMask0);
+		vst3q_u8(&pOut[nCurrSize * 3], tPix);
+	}
+	RLS_Convert_565to888_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_888to565_NEON
+**
+** Description:
+**     NEON RGB888 to RGB565, 16 pixels per step with a deinterleaving load
+**
+** Input:
+**     pSrc - Source pixels
+**     pDest - Destination pixels
+**     nSize - Pixel count
+**
+** Output:
+**     Converted pixels
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_888to565_NEON(const RGB888_T* pSrc,
+									  RGB565_T* pDest, int nSize)
+{
+	const uint8x16_t tMask0 = vdupq_n_u8(0xF8);
+	const uint8x16_t tMask1 = vdupq_n_u8(0xFC);
+	const uint8_t* pIn = (const uint8_t*)pSrc;
+	int nCurrSize;
+
+	for (nCurrSize = 0; nCurrSize + 16 <= nSize; nCurrSize += 16)
+	{
+		uint8x16x3_t tPix = vld3q_u8(&pIn[nCurrSize * 3]);
+		uint8x16_t tB = vandq_u8(tPix.val[0], tMask0);
+		uint8x16_t tG = vandq_u8(tPix.val[1], tMask1);
+		uint8x16_t tR = vshrq_n_u8(tPix.val[2], 3);
+		vst1q_u16(&pDest[nCurrSize],
+				  vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(tB), 8),
+									  vshll_n_u8(vget_low_u8(tG), 3)),
+							vmovl_u8(vget_low_u8(tR))));
+		vst1q_u16(&pDest[nCurrSize + 8],
+				  vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(tB), 8),
+									  vshll_n_u8(vget_high_u8(tG), 3)),
+							vmovl_u8(vget_high_u8(tR))));
+	}
+	RLS_Convert_888to565_C(&pSrc[nCurrSize], &pDest[nCurrSize],
+						   nSize - nCurrSize);
+}
+#endif
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_SelectKernels
+**
+** Description:
+**     Picks the fastest conversion kernels the CPU supports, once
+**
+** Input:
+**     none
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Convert_SelectKernels(void)
+{
+	RLSCvt565to888Fn_T pfn565to888 = RLS_Convert_565to888_C;
+	RLSCvt888to565Fn_T pfn888to565 = RLS_Convert_888to565_C;
+#ifdef RLS_CVT_X86
+	bool bSSSE3, bAVX2;
+	RLS_Convert_GetX86Caps(&bSSSE3, &bAVX2);
+	if (bAVX2)
+	{
+		pfn565to888 = RLS_Convert_565to888_AVX2;
+		pfn888to565 = RLS_Convert_888to565_AVX2;
+	}
+	else if (bSSSE3)
+	{
+		pfn565to888 = RLS_Convert_565to888_SSSE3;
+		pfn888to565 = RLS_Convert_888to565_SSSE3;
+	}
+#elif defined(RLS_CVT_NEON)
+	pfn565to888 = RLS_Convert_565to888_NEON;
+	pfn888to565 = RLS_Convert_888to565_NEON;
+#endif
+	/* every thread selects the same pair, so racing here is harmless */
+	RLS_Convert_pfn888to565 = pfn888to565;
+	RLS_Convert_pfn565to888 = pfn565to888;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_PNGRowsto565
+**
+** Description:
+**     Decodes the rows of an opened PNG one at a time, converting each one
+**     to RGB565 as it arrives
+**
+** Input:
+**     ptPNGCtx - Decoder with the IHDR already read
+**     ptPNGIHDR - Image header
+**     pDest - Zeroed RGB565 image
+**
+** Output:
+**     Converted image
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Convert_PNGRowsto565(spng_ctx* ptPNGCtx,
+									 const struct spng_ihdr* ptPNGIHDR,
+									 RGB565_T* pDest)
+{
+	int iSPNGResult = 0;
+	struct spng_row_info tPNGRow = { 0 };
+	size_t nRowSize = ptPNGIHDR->width * sizeof(RGB888_T);
+	RGB888_T* pRow;
+
+	if (spng_decode_image(ptPNGCtx, NULL, 0, SPNG_FMT_RGB8,
+						  SPNG_DECODE_PROGRESSIVE))
+		return false;
+	pRow = (RGB888_T*)malloc(nRowSize);
+	if (!pRow)
+		return false;
+	do
+	{
+		RGB565_T* pDestRow;
+		iSPNGResult = spng_get_row_info(ptPNGCtx, &tPNGRow);
+		if (iSPNGResult)
+			break;
+		pDestRow = &pDest[(size_t)ptPNGIHDR->width * tPNGRow.row_num];
+		/* an interlaced pass only writes its own pixels, so seed the row
+		   with what earlier passes produced (565 -> 888 -> 565 is exact) */
+		if (ptPNGIHDR->interlace_method)
+			RLS_Convert_565to888(pDestRow, pRow, ptPNGIHDR->width, 1);
+		iSPNGResult = spng_decode_row(ptPNGCtx, pRow, nRowSize);
+		if (iSPNGResult && iSPNGResult != SPNG_EOI)
+			break;
+		RLS_Convert_888to565(pRow, pDestRow, ptPNGIHDR->width, 1);
+	} while (!iSPNGResult);
+	free(pRow);
+	return iSPNGResult == SPNG_EOI;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_PNGPalIdx
+**
+** Description:
+**     Looks a color up in a PNG palette, optionally adding it
+**
+** Input:
+**     ptPal - Palette
+**     wCol - RGB565 color
+**     bAdd - Add the color if missing
+**
+** Output:
+**     Palette
+**
+** Return value:
+**     Palette index, -1 if missing (or the palette is full)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
 */
 
+static int RLS_Convert_PNGPalIdx(RLSPNGPal_T* ptPal, uint16_t wCol,
+								 bool bAdd)
+{
+	unsigned nSlot = ((wCol * 40503u) & 0xFFFF) >> 6;
+	for (;; nSlot++)
+	{
+		nSlot &= RLS_PNG_PAL_HASH - 1;
+		if (ptPal->anIdx[nSlot] < 0)
+			break;
+		if (ptPal->awKey[nSlot] == wCol)
+			return ptPal->anIdx[nSlot];
+	}
+	if (!bAdd || ptPal->nCols == RLS_PNG_PAL_SIZE)
+		return -1;
+	ptPal->awKey[nSlot] = wCol;
+	ptPal->anIdx[nSlot] = (int16_t)ptPal->nCols;
+	ptPal->awCol[ptPal->nCols] = wCol;
+	return ptPal->nCols++;
+}
+
 /*
-**----------------------------------------------------------------------------
-**  Global variables
-**----------------------------------------------------------------------------
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_MakePNGPal
+**
+** Description:
+**     Collects the colors of an image into a PNG palette
+**
+** Input:
+**     pImg - Image
+**     nWidth - Width
+**     nHeight - Height
+**     ptPal - Palette
+**
+** Output:
+**     Palette
+**
+** Return value:
+**     true if the image has at most RLS_PNG_PAL_SIZE colors
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
 */
 
+static bool RLS_Convert_MakePNGPal(const RGB565_T* pImg, int nWidth,
+								   int nHeight, RLSPNGPal_T* ptPal)
+{
+	size_t nSize = (size_t)nWidth * nHeight;
+	size_t nCurrSize;
+	memset(ptPal->anIdx, 0xFF, sizeof(ptPal->anIdx));
+	ptPal->nCols = 0;
+	for (nCurrSize = 0; nCurrSize < nSize; nCurrSize++)
+	{
+		/* runs of one color are common, skip the hash for them */
+		if (nCurrSize && pImg[nCurrSize] == pImg[nCurrSize - 1])
+			continue;
+		if (RLS_Convert_PNGPalIdx(ptPal, pImg[nCurrSize], true) < 0)
+			return false;
+	}
+	return true;
+}
+
 /*
-**----------------------------------------------------------------------------
-**  Internal variables
-**----------------------------------------------------------------------------
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_PNGRow
+**
+** Description:
+**     Makes the unfiltered PNG bytes of an image row, RGB888 or packed
+**     palette indices (RLS_PPNG_RowFn_T)
+**
+** Input:
+**     pArg - Row source
+**     nRow - Row
+**     pRow - Row buffer
+**
+** Output:
+**     Row bytes
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
 */
 
+static void RLS_Convert_PNGRow(void* pArg, int nRow, uint8_t* pRow)
+{
+	RLSPNGRowSrc_T* ptSrc = (RLSPNGRowSrc_T*)pArg;
+	RGB565_T* pSrcRow = &ptSrc->pImg[(size_t)ptSrc->nWidth * nRow];
+	int nCol, nBits = ptSrc->nBits;
+
+	if (!ptSrc->ptPal)
+	{
+		RLS_Convert_565to888(pSrcRow, (RGB888_T*)pRow, ptSrc->nWidth, 1);
+		return;
+	}
+	/* samples are packed MSB first */
+	memset(pRow, 0, ((size_t)ptSrc->nWidth * nBits + 7) / 8);
+	for (nCol = 0; nCol < ptSrc->nWidth; nCol++)
+	{
+		int nIdx = RLS_Convert_PNGPalIdx(ptSrc->ptPal, pSrcRow[nCol], false);
+		int nBit = nCol * nBits;
+		pRow[nBit >> 3] |= (uint8_t)(nIdx << (8 - nBits - (nBit & 7)));
+	}
+}
+
 /*
-**----------------------------------------------------------------------------
-**  Function(internal use only) Declarations
-**----------------------------------------------------------------------------
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_565toPNGRows
+**
+** Description:
+**     Feeds an image to a PNG encoder one converted row at a time
+**
+** Input:
+**     ptPNGCtx - Encoder with the IHDR and output set
+**     ptSrc - Row source
+**     nHeight - Height
+**     nRowSize - Row size
+**
+** Output:
+**     none
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Rows from RLS_Convert_PNGRow
+** 10/18/2026	agent			Indexed rows
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
 */
 
+static bool RLS_Convert_565toPNGRows(spng_ctx* ptPNGCtx,
+									 RLSPNGRowSrc_T* ptSrc, int nHeight,
+									 size_t nRowSize)
+{
+	int iSPNGResult = 0;
+	uint8_t* pRow;
+	int nRow;
+
+	if (spng_encode_image(ptPNGCtx, NULL, 0, SPNG_FMT_PNG,
+						  SPNG_ENCODE_PROGRESSIVE | SPNG_ENCODE_FINALIZE))
+		return false;
+	pRow = (uint8_t*)malloc(nRowSize);
+	if (!pRow)
+		return false;
+	for (nRow = 0; nRow < nHeight; nRow++)
+	{
+		RLS_Convert_PNGRow(ptSrc, nRow, pRow);
+		iSPNGResult = spng_encode_row(ptPNGCtx, pRow, nRowSize);
+		if (iSPNGResult)
+			break;
+	}
+	free(pRow);
+	/* the last row finalizes the file and reports end of image */
+	return iSPNGResult == SPNG_EOI;
+}
+
 /*
 **----------------------------------------------------------------------------
 **  Function(internal and external use) Declarations
@@ -80,6 +1012,7 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Dispatch to SIMD kernels
 ** 08/24/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
@@ -87,17 +1020,11 @@
 bool RLS_Convert_565to888(RGB565_T* pSrc,RGB888_T* pDest,int nWidth,
 						  int nHeight)
 {
-	int nSize;
-	int nCurrSize;
 	if (!pSrc || !pDest || nWidth <= 0 || nHeight <= 0)
 		return false;
-	nSize = nWidth * nHeight;
-	for (nCurrSize = 0; nCurrSize < nSize; nCurrSize++)
-	{
-		pDest[nCurrSize].b = CVT_16BPP_EX_B(pSrc[nCurrSize]);
-		pDest[nCurrSize].g = CVT_16BPP_EX_G(pSrc[nCurrSize]);
-		pDest[nCurrSize].r = CVT_16BPP_EX_R(pSrc[nCurrSize]);
-	}
+	if (!RLS_Convert_pfn565to888)
+		RLS_Convert_SelectKernels();
+	RLS_Convert_pfn565to888(pSrc, pDest, nWidth * nHeight);
 	return true;
 }
 
@@ -125,6 +1052,7 @@ bool RLS_Convert_565to888(RGB565_T* pSrc,RGB888_T* pDest,int nWidth,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Dispatch to SIMD kernels
 ** 08/24/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
@@ -132,15 +1060,11 @@ bool RLS_Convert_565to888(RGB565_T* pSrc,RGB888_T* pDest,int nWidth,
 bool RLS_Convert_888to565(RGB888_T* pSrc,RGB565_T* pDest,int nWidth,
 						  int nHeight)
 {
-	int nSize;
-	int nCurrSize;
 	if (!pSrc || !pDest || nWidth <= 0 || nHeight <= 0)
 		return false;
-	nSize = nWidth * nHeight;
-	for (nCurrSize = 0; nCurrSize < nSize; nCurrSize++)
-		pDest[nCurrSize] = ((pSrc[nCurrSize].b >> 3) << 11)
-					   | ((pSrc[nCurrSize].g >> 2) << 5)
-					   | (pSrc[nCurrSize].r >> 3);
+	if (!RLS_Convert_pfn888to565)
+		RLS_Convert_SelectKernels();
+	RLS_Convert_pfn888to565(pSrc, pDest, nWidth * nHeight);
 	return true;
 }
 
@@ -150,6 +1074,150 @@ bool RLS_Convert_888to565(RGB888_T* pSrc,RGB565_T* pDest,int nWidth,
 **----------------------------------------------------------------------------
 */
 
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_SetPNGProfile
+**
+** Description:
+**     Sets the PNG export profile: store (no compression), fast (deflate
+**     level 1, Paeth filter only) or max (level 9, adaptive filtering, the
+**     default)
+**
+** Input:
+**     eProfile - Export profile
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Convert_SetPNGProfile(RLS_PNGP_E eProfile)
+{
+	switch (eProfile)
+	{
+	case RLS_PNGP_STORE:
+		RLS_Convert_PNGLevel = 0;
+		RLS_Convert_PNGProfFilters = RLS_PNGF_NONE;
+		break;
+	case RLS_PNGP_FAST:
+		RLS_Convert_PNGLevel = 1;
+		RLS_Convert_PNGProfFilters = RLS_PNGF_PAETH;
+		break;
+	default:
+		RLS_Convert_PNGLevel = 9;
+		RLS_Convert_PNGProfFilters = RLS_PNGF_ALL;
+		break;
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_SetPNGFilters
+**
+** Description:
+**     Overrides the filters the PNG encoder may choose from per row
+**
+** Input:
+**     nFilters - RLS_PNGF_* combination, RLS_PNGF_PROFILE for the profile's
+**                own choice
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Convert_SetPNGFilters(int nFilters)
+{
+	if (nFilters != RLS_PNGF_PROFILE
+	 && (nFilters <= 0 || (nFilters & ~RLS_PNGF_ALL)))
+		return;
+	RLS_Convert_PNGFilters = nFilters;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_SetPNGIndexed
+**
+** Description:
+**     Enables writing images with at most 256 colors as indexed PNGs
+**     (PLTE + 1/2/4/8-bit indices) instead of truecolor
+**
+** Input:
+**     bIndexed - true/false
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Convert_SetPNGIndexed(bool bIndexed)
+{
+	RLS_Convert_PNGIndexed = bIndexed;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Convert_SetPNGThreads
+**
+** Description:
+**     Sets how many threads may compress one PNG. Images big enough to be
+**     split (RLS_PPNG_MIN_STRIP raw bytes per thread) are then written by
+**     the parallel writer instead of spng.
+**
+** Input:
+**     nThreads - Thread count, 0 - one per CPU, 1 - never split
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Convert_SetPNGThreads(int nThreads)
+{
+	if (nThreads >= 0)
+		RLS_Convert_PNGThreads = nThreads;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 **
@@ -157,7 +1225,10 @@ bool RLS_Convert_888to565(RGB888_T* pSrc,RGB565_T* pDest,int nWidth,
 **     RLS_Convert_565toPNG
 **
 ** Description:
-**     Convert an RGB565 image to a PNG file
+**     Convert an RGB565 image to a PNG file. Rows are converted one at a
+**     time and fed to the encoder, which writes straight to the file.
+**     With indexed output on, images of at most 256 colors are written
+**     with a palette. Large images are compressed on several threads.
 **
 ** Input:
 **     pszFn - File name
@@ -174,64 +1245,116 @@ bool RLS_Convert_888to565(RGB888_T* pSrc,RGB565_T* pDest,int nWidth,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Parallel writer for large images
+** 10/18/2026	agent			Indexed output
+** 10/18/2026	agent			Progressive encode to file, fixed leaks
+** 10/18/2026	agent			Use export profile and filter choice
 ** 08/24/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 bool RLS_Convert_565toPNG(RGB565_T* pImg, const char* pszFn, int nWidth,
 						  int nHeight)
 {
-	int iSPNGResult = 0;
-	void* pPNGBuff;
-	size_t nPNGSize;
 	FILE* pFile;
 	spng_ctx* ptPNGCtx = NULL;
 	struct spng_ihdr tPNGIHDR = { 0 }; /* zero-init to set valid defaults */
-	RGB888_T* cvt_buff;
+	struct spng_plte tPNGPLTE = { 0 };
+	RLSPNGPal_T tPal;
+	RLSPNGRowSrc_T tSrc;
+	size_t nRowSize;
+	int nFilters = RLS_Convert_PNGFilters != RLS_PNGF_PROFILE
+				 ? RLS_Convert_PNGFilters : RLS_Convert_PNGProfFilters;
+	int nThreads = RLS_Convert_PNGThreads ? RLS_Convert_PNGThreads
+										  : RLS_Thread_GetCPUs();
+	bool bResult = false;
+	int nCol;
+
+	if (!pImg || !pszFn || nWidth <= 0 || nHeight <= 0)
+		return false;
+	/* pick the kernels here, before any writer thread converts rows */
+	if (!RLS_Convert_pfn565to888)
+		RLS_Convert_SelectKernels();
 
 	tPNGIHDR.width = nWidth;
 	tPNGIHDR.height = nHeight;
 	tPNGIHDR.bit_depth = 8;
 	tPNGIHDR.color_type = SPNG_COLOR_TYPE_TRUECOLOR;
+	tSrc.pImg = pImg;
+	tSrc.nWidth = nWidth;
+	tSrc.ptPal = NULL;
+	tSrc.nBits = 8;
 
-	ptPNGCtx = spng_ctx_new(SPNG_CTX_ENCODER);
-	spng_set_option(ptPNGCtx, SPNG_IMG_COMPRESSION_LEVEL, 9);
-	spng_set_option(ptPNGCtx, SPNG_ENCODE_TO_BUFFER, 1);
-	spng_set_ihdr(ptPNGCtx, &tPNGIHDR);
-
-	cvt_buff = (RGB888_T*)malloc(nWidth * nHeight * sizeof(RGB888_T));
-	if (!cvt_buff)
-		return false;
-	if (RLS_Convert_565to888(pImg, cvt_buff, nWidth, nHeight) == false)
-		return false;
-	iSPNGResult = spng_encode_image(ptPNGCtx, cvt_buff,
-									nWidth * nHeight * sizeof(RGB888_T),
-								    SPNG_FMT_PNG, SPNG_ENCODE_FINALIZE);
-
-	if (iSPNGResult) {
-		spng_ctx_free(ptPNGCtx);
-		return false;
-	}
-
-	pPNGBuff = spng_get_png_buffer(ptPNGCtx, &nPNGSize, &iSPNGResult);
-
-	if (pPNGBuff == NULL)
+	if (RLS_Convert_PNGIndexed
+	 && RLS_Convert_MakePNGPal(pImg, nWidth, nHeight, &tPal))
 	{
-		spng_ctx_free(ptPNGCtx);
-		return false;
+		tSrc.ptPal = &tPal;
+		tPNGIHDR.color_type = SPNG_COLOR_TYPE_INDEXED;
+		tPNGIHDR.bit_depth = tPal.nCols <= 2 ? 1 : tPal.nCols <= 4 ? 2
+						   : tPal.nCols <= 16 ? 4 : 8;
+		tSrc.nBits = tPNGIHDR.bit_depth;
+		tPNGPLTE.n_entries = tPal.nCols;
+		/* RGB888_T.b holds the first (PNG red) byte, see CVT_16BPP_EX_B */
+		for (nCol = 0; nCol < tPal.nCols; nCol++)
+		{
+			tPNGPLTE.entries[nCol].red = CVT_16BPP_EX_B(tPal.awCol[nCol]);
+			tPNGPLTE.entries[nCol].green = CVT_16BPP_EX_G(tPal.awCol[nCol]);
+			tPNGPLTE.entries[nCol].blue = CVT_16BPP_EX_R(tPal.awCol[nCol]);
+		}
+		nRowSize = ((size_t)nWidth * tSrc.nBits + 7) / 8;
 	}
+	else
+		nRowSize = nWidth * sizeof(RGB888_T);
 
 	pFile = fopen(pszFn, "wb");
-	if (pFile == NULL) {
-		free(pPNGBuff);
-		spng_ctx_free(ptPNGCtx);
+	if (pFile == NULL)
 		return false;
+	if (nThreads > 1
+	 && (uint64_t)nHeight * (nRowSize + 1) >= 2 * RLS_PPNG_MIN_STRIP)
+	{
+		RLSPPNGInfo_T tInfo;
+		uint8_t abPLTE[RLS_PNG_PAL_SIZE * 3];
+		for (nCol = 0; nCol < (int)tPNGPLTE.n_entries; nCol++)
+		{
+			abPLTE[nCol * 3] = tPNGPLTE.entries[nCol].red;
+			abPLTE[nCol * 3 + 1] = tPNGPLTE.entries[nCol].green;
+			abPLTE[nCol * 3 + 2] = tPNGPLTE.entries[nCol].blue;
+		}
+		tInfo.nWidth = nWidth;
+		tInfo.nHeight = nHeight;
+		tInfo.nBitDepth = tPNGIHDR.bit_depth;
+		tInfo.nColorType = tSrc.ptPal ? RLS_PPNG_CT_INDEXED
+									  : RLS_PPNG_CT_TRUECOLOR;
+		tInfo.nPixelBytes = tSrc.ptPal ? 1 : sizeof(RGB888_T);
+		tInfo.nRowSize = nRowSize;
+		tInfo.pPLTE = abPLTE;
+		tInfo.nPLTECols = tPNGPLTE.n_entries;
+		tInfo.nLevel = RLS_Convert_PNGLevel;
+		tInfo.nFilters = nFilters;
+		tInfo.pfnRow = RLS_Convert_PNGRow;
+		tInfo.pRowArg = &tSrc;
+		bResult = RLS_PPNG_Write(pFile, &tInfo, nThreads);
 	}
-
-	fwrite(pPNGBuff, nPNGSize, 1, pFile);
-	fclose(pFile);
-	free(pPNGBuff);
-	spng_ctx_free(ptPNGCtx);
-	return true;
+	else
+	{
+		ptPNGCtx = spng_ctx_new(SPNG_CTX_ENCODER);
+		if (ptPNGCtx)
+		{
+			spng_set_option(ptPNGCtx, SPNG_IMG_COMPRESSION_LEVEL,
+							RLS_Convert_PNGLevel);
+			spng_set_option(ptPNGCtx, SPNG_FILTER_CHOICE, nFilters);
+			if (!spng_set_ihdr(ptPNGCtx, &tPNGIHDR)
+			 && (!tSrc.ptPal || !spng_set_plte(ptPNGCtx, &tPNGPLTE))
+			 && !spng_set_png_file(ptPNGCtx, pFile))
+				bResult = RLS_Convert_565toPNGRows(ptPNGCtx, &tSrc, nHeight,
+												   nRowSize);
+			spng_ctx_free(ptPNGCtx);
+		}
+	}
+	if (fclose(pFile) != 0)
+		bResult = false;
+	if (!bResult)
+		remove(pszFn);
+	return bResult;
 }
 
 /*
@@ -241,7 +1364,9 @@ bool RLS_Convert_565toPNG(RGB565_T* pImg, const char* pszFn, int nWidth,
 **     RLS_Convert_PNGto565
 **
 ** Description:
-**     Convert a PNG file to an RGB565 image
+**     Convert a PNG file to an RGB565 image. The file is decoded straight
+**     from disk row by row, so besides the result only one RGB888 row is
+**     held in memory.
 **
 ** Input:
 **     pszFn - File name
@@ -252,79 +1377,53 @@ bool RLS_Convert_565toPNG(RGB565_T* pImg, const char* pszFn, int nWidth,
 **     Converted image
 **
 ** Return value:
-**     true/false
+**     Image (free with free()) or NULL
 **
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Progressive decode, fixed leaks
 ** 08/26/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
 RGB565_T* RLS_Convert_PNGto565(const char* pszFn, int* pnWidth, int* pnHeight)
 {
-	int iSPNGResult = 0;
-	uint8_t* pPNGBuff;
-	size_t nPNGSize;
 	FILE* pFile;
 	spng_ctx* ptPNGCtx = NULL;
 	struct spng_ihdr tPNGIHDR = { 0 }; /* zero-init to set valid defaults */
-	RGB888_T* tmp_sbuff;
-	RGB565_T* cvt_buff;
+	RGB565_T* cvt_buff = NULL;
 
+	if (!pszFn || !pnWidth || !pnHeight)
+		return NULL;
 	pFile = fopen(pszFn, "rb");
-	if (pFile == NULL) {
-		return false;
-	}
-	fseek(pFile, 0, SEEK_END);
-	nPNGSize = ftell(pFile);
-	fseek(pFile, 0, SEEK_SET);
-	pPNGBuff = (uint8_t*)malloc(nPNGSize);
-	if (pPNGBuff == NULL) {
-		fclose(pFile);
-		return false;
-	}
-	fread(pPNGBuff, nPNGSize, 1, pFile);
-	fclose(pFile);
-
-	ptPNGCtx = spng_ctx_new(0);
-
-	if (!ptPNGCtx)
+	if (pFile == NULL)
 		return NULL;
 
-	spng_set_png_buffer(ptPNGCtx, pPNGBuff, nPNGSize);
-
-	//if (iSPNGResult) {
-	//	spng_ctx_free(ptPNGCtx);
-	//	return NULL;
-	//}
-
-	if(spng_get_ihdr(ptPNGCtx, &tPNGIHDR))
+	ptPNGCtx = spng_ctx_new(0);
+	/* spng caps dimensions at 2^31 - 1, keep the image addressable */
+	if (ptPNGCtx && !spng_set_png_file(ptPNGCtx, pFile)
+	 && !spng_get_ihdr(ptPNGCtx, &tPNGIHDR)
+	 && (size_t)tPNGIHDR.width * tPNGIHDR.height
+	  <= (size_t)-1 / sizeof(RGB888_T) / 2)
 	{
-		spng_ctx_free(ptPNGCtx);
-		return NULL;
+		/* zeroed: interlaced passes only fill in part of a row at a time */
+		cvt_buff = (RGB565_T*)calloc((size_t)tPNGIHDR.width
+								   * tPNGIHDR.height, sizeof(RGB565_T));
+		if (cvt_buff
+		 && !RLS_Convert_PNGRowsto565(ptPNGCtx, &tPNGIHDR, cvt_buff))
+		{
+			free(cvt_buff);
+			cvt_buff = NULL;
+		}
 	}
-
-	*pnWidth = tPNGIHDR.width;
-	*pnHeight = tPNGIHDR.height;
-
-	tmp_sbuff = (RGB888_T*)malloc(tPNGIHDR.width * tPNGIHDR.height
-							    * sizeof(RGB888_T));
-	if (!tmp_sbuff)
-		return NULL;
-	if (spng_decode_image(ptPNGCtx, tmp_sbuff,
-						  tPNGIHDR.width * tPNGIHDR.height
-						* sizeof(RGB888_T), SPNG_FMT_RGB8, 0))
-		return NULL;
-	cvt_buff = (RGB565_T*)malloc(tPNGIHDR.width * tPNGIHDR.height
-							    * sizeof(RGB565_T));
-	if (!cvt_buff)
-		return NULL;
-	if (RLS_Convert_888to565(tmp_sbuff, cvt_buff,
-							 tPNGIHDR.width,
-							 tPNGIHDR.height) == false)
-		return NULL;
-	free(tmp_sbuff);
 	spng_ctx_free(ptPNGCtx);
+	fclose(pFile);
+
+	if (cvt_buff)
+	{
+		*pnWidth = tPNGIHDR.width;
+		*pnHeight = tPNGIHDR.height;
+	}
 	return cvt_buff;
 }
\ No newline at end of file
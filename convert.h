@@ -6,6 +6,9 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			PNG export thread count
+** 10/18/2026	agent			Indexed PNG export
+** 10/18/2026	agent			PNG export profiles and filter choice
 ** 08/26/2024	raulmrio28-git	PNG to RGB565
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
@@ -37,12 +40,28 @@ extern "C" {
 #define CVT_16BPP_EX_G(x) (((x>>5)&0x3f) << 2)
 #define CVT_16BPP_EX_R(x) ((x&0x1f) << 3)
 
+/* PNG export filter choices, same bits as SPNG_FILTER_CHOICE_* */
+#define RLS_PNGF_PROFILE -1 /* whatever the export profile uses */
+#define RLS_PNGF_NONE 0x08
+#define RLS_PNGF_SUB 0x10
+#define RLS_PNGF_UP 0x20
+#define RLS_PNGF_AVG 0x40
+#define RLS_PNGF_PAETH 0x80
+#define RLS_PNGF_ALL 0xF8
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
 **----------------------------------------------------------------------------
 */
 
+typedef enum tagRLS_PNGP_E
+{
+	RLS_PNGP_STORE = 0, /* no compression, no filtering */
+	RLS_PNGP_FAST = 1, /* level 1, one filter */
+	RLS_PNGP_MAX = 2 /* level 9, adaptive filtering (default) */
+} RLS_PNGP_E;
+
 typedef uint16_t RGB565_T;
 typedef struct tagRGB888_T RGB888_T;
 
@@ -76,6 +95,10 @@ extern bool RLS_Convert_888to565(RGB888_T* pSrc, RGB565_T* pDest, int nWidth,
 **----------------------------------------------------------------------------
 */
 
+extern void RLS_Convert_SetPNGProfile(RLS_PNGP_E eProfile);
+extern void RLS_Convert_SetPNGFilters(int nFilters);
+extern void RLS_Convert_SetPNGIndexed(bool bIndexed);
+extern void RLS_Convert_SetPNGThreads(int nThreads);
 extern bool RLS_Convert_565toPNG(RGB565_T* pImg,const char* pszFn, int nWidth,
 								 int nHeight);
 
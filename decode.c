@@ -6,6 +6,11 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Bound block decoding by the frame data
+** 10/18/2026	agent			Check located frames against the data size
+** 10/18/2026	agent			Changed rectangles at odd edges
+** 10/18/2026	agent			Frame index, skip frames by their sizes
+** 10/18/2026	agent			Row stride parameters
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
 */
@@ -18,6 +23,7 @@
 
 #define RLS_EXTERN_VAR
 #include "common.h"
+#include "decode.h"
 #include <stdio.h>
 #include <memory.h>
 
@@ -65,33 +71,42 @@
 **
 ** Input:
 **     pIn - input data
+**     pInEnd - end of the frame's block data
+**     nExtColors - extended palette colors of the frame
 **     pOut - output data
 **
 ** Output:
 **     Decoded block to pOut
 **
 ** Return value:
-**     nOffset
+**     nOffset/0 (block reads past the data or the extended palette)
 **
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Bounded by the data and extended palette
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
-uint32_t RLS_Decode_DecodeBlk(uint8_t* pIn, uint16_t* pOut)
+uint32_t RLS_Decode_DecodeBlk(uint8_t* pIn, const uint8_t* pInEnd,
+							  uint32_t nExtColors, uint16_t* pOut)
 {
 	RLSBkInfo_T tBkInfo;
 	uint8_t nBkPix;
 	uint32_t nOffset = 0;
+	if (pIn >= pInEnd)
+		return 0;
 	memcpy(&tBkInfo, &pIn[nOffset++], sizeof(RLSBkInfo_T));
 	if (tBkInfo.nPbIdx == 0xf) {
 		for (nBkPix = 0; nBkPix < 2*2; nBkPix++)
 		{
-			if (RLS_BKI_PU_GB(tBkInfo.baPalBits, nBkPix) == RLS_BKI_PAL_EP)
-				RLS_Common_Block[nBkPix]
-			  = RLS_Common_ExtPal[RLS_Common_ExtPal_CIdx++];
+			if (RLS_BKI_PU_GB(tBkInfo.baPalBits, nBkPix) != RLS_BKI_PAL_EP)
+				continue;
+			if (RLS_Common_ExtPal_CIdx >= nExtColors)
+				return 0;
+			RLS_Common_Block[nBkPix]
+		  = RLS_Common_ExtPal[RLS_Common_ExtPal_CIdx++];
 		}
 	}
 	else {
@@ -102,21 +117,94 @@ uint32_t RLS_Decode_DecodeBlk(uint8_t* pIn, uint16_t* pOut)
 			if (RLS_BKI_PU_GB(pal_bits, nBkPix)==RLS_BKI_PU_USEB && nBkPix>0)
 				RLS_Common_Block[nBkPix]
 			   =RLS_Common_Block[RLS_BKI_BI_GB(bk_idx,nBkPix)];
+			else if (RLS_BKI_PU_GB(tBkInfo.baPalBits, nBkPix)==RLS_BKI_PAL_SP)
+			{
+				if (pIn + nOffset >= pInEnd)
+					return 0;
+				RLS_Common_Block[nBkPix]
+			  = RLS_Common_StdPal[pIn[nOffset++]];
+			}
 			else
 			{
-				if (RLS_BKI_PU_GB(tBkInfo.baPalBits, nBkPix)==RLS_BKI_PAL_SP)
-					RLS_Common_Block[nBkPix]
-				  = RLS_Common_StdPal[pIn[nOffset++]];
-				else
-					RLS_Common_Block[nBkPix]
-				  = RLS_Common_ExtPal[RLS_Common_ExtPal_CIdx++];
-
+				if (RLS_Common_ExtPal_CIdx >= nExtColors)
+					return 0;
+				RLS_Common_Block[nBkPix]
+			  = RLS_Common_ExtPal[RLS_Common_ExtPal_CIdx++];
 			}
 		}
 	}
 	return nOffset;
 }
 
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Decode_AddRect
+**
+** Description:
+**     Adds the changed span of a block row, growing the last rectangle
+**     when it covers the same columns of the row above
+**
+** Input:
+**     ptRects - changed rectangles
+**     pnRects - changed rectangle count
+**     nMaxRects - room in ptRects
+**     nX - span start in pixels
+**     nY - block row top in pixels
+**     nWidth - span width in pixels
+**     nHeight - block row height in pixels (1 at an odd bottom edge)
+**
+** Output:
+**     Changed rectangles
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Odd widths and heights
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Decode_AddRect(RLSRect_T* ptRects, int* pnRects, int nMaxRects,
+						int nX, int nY, int nWidth, int nHeight)
+{
+	RLSRect_T* ptLast = *pnRects ? &ptRects[*pnRects - 1] : NULL;
+	int nRight, nBottom;
+
+	if (ptLast && ptLast->nX == nX && ptLast->nWidth == nWidth
+	 && ptLast->nY + ptLast->nHeight == nY)
+	{
+		ptLast->nHeight += nHeight;
+		return;
+	}
+	if (*pnRects < nMaxRects)
+	{
+		ptLast = &ptRects[(*pnRects)++];
+		ptLast->nX = nX;
+		ptLast->nY = nY;
+		ptLast->nWidth = nWidth;
+		ptLast->nHeight = nHeight;
+		return;
+	}
+	/* out of room, cover it all */
+	nRight = ptLast->nX + ptLast->nWidth;
+	nBottom = ptLast->nY + ptLast->nHeight;
+	if (nX < ptLast->nX)
+		ptLast->nX = nX;
+	if (nX + nWidth > nRight)
+		nRight = nX + nWidth;
+	if (nY < ptLast->nY)
+		ptLast->nY = nY;
+	if (nY + nHeight > nBottom)
+		nBottom = nY + nHeight;
+	ptLast->nWidth = nRight - ptLast->nX;
+	ptLast->nHeight = nBottom - ptLast->nY;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 **
@@ -131,30 +219,46 @@ uint32_t RLS_Decode_DecodeBlk(uint8_t* pIn, uint16_t* pOut)
 **     pOut - output data
 **     nWidth - width
 **     nHeight - height
+**     nStride - output row stride in pixels
+**     ptRects - changed rectangles (RLS_DECODE_RECTS(nHeight)), NULL if
+**               not wanted
+**     pnRects - changed rectangle count
 **
 ** Output:
-**     Decoded frame to pOut
+**     Decoded frame to pOut, changed rectangles
 **
 ** Return value:
-**     pCurrInput - pIn
+**     pCurrInput - pIn/0 (blocks do not fit the data size)
 **
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			One bounded pass over the blocks
+** 10/18/2026	agent			Odd widths and heights
+** 10/18/2026	agent			Changed rectangles
+** 10/18/2026	agent			Row stride
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
-uint32_t RLS_Decode_Frame(uint8_t* pIn,uint16_t* pOut,int nWidth,int nHeight)
+uint32_t RLS_Decode_Frame(uint8_t* pIn,uint16_t* pOut,int nWidth,int nHeight,
+						  int nStride, RLSRect_T* ptRects, int* pnRects)
 {
 	uint8_t* pCurrInput = pIn;
 	uint8_t* pInputEnd;
+	uint32_t nExtColors, nBlkSize;
 	bool bNoWrite = false;
 	int nCols = RLS_CEIL(nWidth, 2);
 	int nRows = RLS_CEIL(nHeight, 2);
 	int nCurrCol, nCurrRow;
+	uint16_t anPrevBlock[2*2];
+	int nFirstCol, nLastCol;
 
 	if (!pOut)
 		bNoWrite = true;
+	if (bNoWrite || !ptRects)
+		ptRects = NULL;
+	else
+		*pnRects = 0;
 	memcpy(RLS_Common_StdPal, pCurrInput, RLS_SPAL_SIZE * RLS_PAL_BYTES);
 	pCurrInput += RLS_SPAL_SIZE * RLS_PAL_BYTES;
 	if (*(uint32_t*)pCurrInput > RLS_EPAL_SIZE * RLS_PAL_BYTES)
@@ -162,29 +266,178 @@ uint32_t RLS_Decode_Frame(uint8_t* pIn,uint16_t* pOut,int nWidth,int nHeight)
 	memcpy(RLS_Common_ExtPal, pCurrInput + sizeof(uint32_t),
 		   *(uint32_t*)pCurrInput);
 	RLS_Common_ExtPal_CIdx = 0;
+	nExtColors = *(uint32_t*)pCurrInput / RLS_PAL_BYTES;
 	pCurrInput += *(uint32_t*)pCurrInput + sizeof(uint32_t);
 	pInputEnd = pCurrInput + *(uint32_t*)pCurrInput + sizeof(uint32_t);
 	pCurrInput += sizeof(uint32_t);
-	while (pCurrInput < pInputEnd)
+	/* one pass over the blocks, which must use up the data exactly */
+	for (nCurrRow = 0; nCurrRow < nRows; nCurrRow++)
 	{
-		for (nCurrRow = 0; nCurrRow < nRows; nCurrRow++)
+		nFirstCol = nCols;
+		nLastCol = -1;
+		for (nCurrCol = 0; nCurrCol < nCols; nCurrCol++)
 		{
-			for (nCurrCol = 0; nCurrCol < nCols; nCurrCol++)
+			if (bNoWrite == false && RLS_Common_ExtractBlock(pOut, nWidth,
+				nHeight, nStride, nCurrCol, nCurrRow) == false)
+				return 0;
+			if (ptRects)
+				memcpy(anPrevBlock, RLS_Common_Block, sizeof(anPrevBlock));
+			nBlkSize = RLS_Decode_DecodeBlk(pCurrInput, pInputEnd,
+											nExtColors, RLS_Common_Block);
+			if (!nBlkSize)
+				return 0;
+			pCurrInput += nBlkSize;
+			/* the output holds the previous frame, unchanged blocks need
+			   no write */
+			if (ptRects)
 			{
-				if (bNoWrite == false && RLS_Common_ExtractBlock(pOut, nWidth,
-					nHeight, nCurrCol, nCurrRow) == false)
-					return 0;
-				pCurrInput += RLS_Decode_DecodeBlk(pCurrInput,
-												   RLS_Common_Block);
-				if (bNoWrite == false && RLS_Common_WriteBlock(pOut, nWidth,
-					nHeight, nCurrCol, nCurrRow) == false)
-					return 0;
+				if (memcmp(anPrevBlock, RLS_Common_Block,
+						   sizeof(anPrevBlock)) == 0)
+					continue;
+				if (nCurrCol < nFirstCol)
+					nFirstCol = nCurrCol;
+				nLastCol = nCurrCol;
 			}
+			if (bNoWrite == false && RLS_Common_WriteBlock(pOut, nWidth,
+				nHeight, nStride, nCurrCol, nCurrRow) == false)
+				return 0;
+		}
+		if (ptRects && nLastCol >= 0)
+		{
+			/* spans end at odd right and bottom edges */
+			int nSpanWidth = (nLastCol - nFirstCol + 1) << 1;
+			int nSpanHeight = 2;
+			if (nSpanWidth > nWidth - (nFirstCol << 1))
+				nSpanWidth = nWidth - (nFirstCol << 1);
+			if (nSpanHeight > nHeight - (nCurrRow << 1))
+				nSpanHeight = nHeight - (nCurrRow << 1);
+			RLS_Decode_AddRect(ptRects, pnRects, nRows, nFirstCol << 1,
+							   nCurrRow << 1, nSpanWidth, nSpanHeight);
 		}
 	}
+	if (pCurrInput != pInputEnd)
+		return 0;
 	return (uint32_t)(pCurrInput - pIn);
 }
 
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Decode_SkipFrame
+**
+** Description:
+**     Steps over a frame using its palette and data sizes only
+**
+** Input:
+**     pIn - input data
+**
+** Output:
+**     none
+**
+** Return value:
+**     Frame size/0 (invalid frame)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Decode_SkipFrame(uint8_t* pIn)
+{
+	uint32_t nOffset = RLS_SPAL_SIZE * RLS_PAL_BYTES;
+	uint32_t nSize;
+	memcpy(&nSize, pIn + nOffset, sizeof(uint32_t));
+	if (nSize > RLS_EPAL_SIZE * RLS_PAL_BYTES)
+		return 0;
+	nOffset += sizeof(uint32_t) + nSize;
+	memcpy(&nSize, pIn + nOffset, sizeof(uint32_t));
+	if (nSize > UINT32_MAX - nOffset - sizeof(uint32_t))
+		return 0;
+	return nOffset + sizeof(uint32_t) + nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Decode_Locate
+**
+** Description:
+**     Finds a frame in a container
+**
+** Input:
+**     pIn - input data
+**     nSize - input data size, 0 if unknown (frame index is not used,
+**             frame sizes are not checked)
+**     nFrame - frame to find
+**     nStride - output row stride in pixels (at least the frame width)
+**     pnWidth - width
+**     pnHeight - height
+**
+** Output:
+**     Frame size
+**
+** Return value:
+**     Frame data/NULL
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check the frame found against nSize
+** 10/18/2026	agent			Split from RLS_Decode
+** ---------------------------------------------------------------------------
+*/
+
+uint8_t* RLS_Decode_Locate(uint8_t* pIn, size_t nSize, int nFrame,
+						   int nStride, int* pnWidth, int* pnHeight)
+{
+	uint8_t* pCurrInput = pIn;
+	int nSkipFrames;
+	int nStart;
+	int nFrames;
+	uint32_t nOffset;
+
+	if ((nSize && nSize < 12) || *(uint16_t*)pCurrInput != RLS_MAGIC)
+		return NULL;
+	*pnWidth = *pnHeight = 0;
+	nStart = RLS_Common_GetInfo(pCurrInput, &nFrames, pnWidth, pnHeight,
+								NULL);
+	/* Invalid information */
+	if (nStart <= 0 || *pnWidth <= 0 || *pnHeight <= 0)
+		return NULL;
+	pCurrInput+=nStart;
+	if (nFrame < 0 || nFrame >= nFrames || nStride < *pnWidth)
+		return NULL;
+	/* one seek with an index, otherwise hop over the earlier frames */
+	nOffset = RLS_Common_GetFrameOffset(pIn, nSize, nFrame);
+	if (nOffset)
+		pCurrInput = pIn + nOffset;
+	for (nSkipFrames = 0; !nOffset && nSkipFrames < nFrame; nSkipFrames++)
+	{
+		uint32_t nFrameSize;
+		if (nSize)
+			nFrameSize = RLS_Common_CheckFrame(pCurrInput,
+											   nSize - (pCurrInput - pIn),
+											   *pnWidth, *pnHeight);
+		else
+			nFrameSize = RLS_Decode_SkipFrame(pCurrInput);
+		if (!nFrameSize
+		 || (nSize && nFrameSize >= nSize - (pCurrInput - pIn)))
+			return NULL;
+		pCurrInput+=nFrameSize;
+	}
+	/* the palette and data sizes of the frame found must fit too,
+	   RLS_Decode_Frame keeps the blocks within them */
+	if (nSize && !RLS_Common_CheckFrame(pCurrInput,
+										nSize - (pCurrInput - pIn),
+										*pnWidth, *pnHeight))
+		return NULL;
+	return pCurrInput;
+}
+
 /*
 **----------------------------------------------------------------------------
 **  Function(external use only) Declarations
@@ -202,8 +455,10 @@ uint32_t RLS_Decode_Frame(uint8_t* pIn,uint16_t* pOut,int nWidth,int nHeight)
 **
 ** Input:
 **     pIn - input data
+**     nSize - input data size, 0 if unknown (frame index is not used)
 **     nFrame - frame to decode
 **     pOut - output data
+**     nStride - output row stride in pixels (at least the frame width)
 **
 ** Output:
 **     Decoded frame to pOut
@@ -214,31 +469,67 @@ uint32_t RLS_Decode_Frame(uint8_t* pIn,uint16_t* pOut,int nWidth,int nHeight)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame lookup moved to RLS_Decode_Locate
+** 10/18/2026	agent			Frame index, skip frames by their sizes
+** 10/18/2026	agent			Row stride
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
-bool RLS_Decode(uint8_t* pIn, int nFrame, uint16_t* pOut)
+bool RLS_Decode(uint8_t* pIn, size_t nSize, int nFrame, uint16_t* pOut,
+				int nStride)
 {
-	uint8_t* pCurrInput = pIn;
+	int nWidth, nHeight;
+	uint8_t* pFrame = RLS_Decode_Locate(pIn, nSize, nFrame, nStride, &nWidth,
+										&nHeight);
+	return pFrame && RLS_Decode_Frame(pFrame, pOut, nWidth, nHeight, nStride,
+									  NULL, NULL);
+}
 
-	if (*(uint16_t*)pCurrInput == RLS_MAGIC) {
-		int nSkipFrames;
-		int nStart;
-		int nFrames;
-		int nWidth;
-		int nHeight;
-		nStart = RLS_Common_GetInfo(pCurrInput, &nFrames, &nWidth,
-									&nHeight, NULL);
-		if (nStart == -1) /* Invalid information */
-			return false;
-		pCurrInput+=nStart;
-		if (nFrame >= nFrames)
-			return false;
-		for (nSkipFrames = 0; nSkipFrames < nFrame; nSkipFrames++)
-			pCurrInput+=RLS_Decode_Frame(pCurrInput, NULL, nWidth, nHeight);
-		if (RLS_Decode_Frame(pCurrInput, pOut, nWidth, nHeight))
-			return true;
-	}
-	return false;
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Decode_Dirty
+**
+** Description:
+**     Decode a frame over the frame shown before it, writing and reporting
+**     only the 2x2 blocks that differ. Changed blocks of a block row make
+**     one span; spans over the same columns of adjacent rows are merged.
+**
+** Input:
+**     pIn - input data
+**     nSize - input data size, 0 if unknown (frame index is not used)
+**     nFrame - frame to decode
+**     pOut - previous frame, output data
+**     nStride - output row stride in pixels (at least the frame width)
+**     ptRects - changed rectangles, room for RLS_DECODE_RECTS(height)
+**     pnRects - changed rectangle count
+**
+** Output:
+**     Decoded frame to pOut, changed rectangles in pixels
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Decode_Dirty(uint8_t* pIn, size_t nSize, int nFrame, uint16_t* pOut,
+					  int nStride, RLSRect_T* ptRects, int* pnRects)
+{
+	int nWidth, nHeight;
+	uint8_t* pFrame;
+
+	*pnRects = 0;
+	if (!pOut || !ptRects)
+		return false;
+	pFrame = RLS_Decode_Locate(pIn, nSize, nFrame, nStride, &nWidth,
+							   &nHeight);
+	return pFrame && RLS_Decode_Frame(pFrame, pOut, nWidth, nHeight, nStride,
+									  ptRects, pnRects);
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Changed rectangle decode
+** 10/18/2026	agent			Frame index, skip frames by their sizes
+** 10/18/2026	agent			Row stride parameters
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
 */
@@ -19,6 +22,7 @@
 **----------------------------------------------------------------------------
 */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -32,12 +36,26 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
+/* room RLS_Decode_Dirty needs for a frame: one rectangle per block row */
+#define RLS_DECODE_RECTS(nHeight) (((nHeight) + 1) >> 1)
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
 **----------------------------------------------------------------------------
 */
 
+typedef struct tagRLSRect_T RLSRect_T;
+
+/* frame area in pixels */
+typedef struct tagRLSRect_T
+{
+	int nX;
+	int nY;
+	int nWidth;
+	int nHeight;
+};
+
 /*
 **----------------------------------------------------------------------------
 **  Variable Declarations
@@ -50,7 +68,11 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
-extern bool RLS_Decode(uint8_t* pIn, int nFrame, uint16_t* pOut);
+extern bool RLS_Decode(uint8_t* pIn, size_t nSize, int nFrame,
+					   uint16_t* pOut, int nStride);
+extern bool RLS_Decode_Dirty(uint8_t* pIn, size_t nSize, int nFrame,
+							 uint16_t* pOut, int nStride, RLSRect_T* ptRects,
+							 int* pnRects);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,413 @@
+/*
+** ===========================================================================
+** File: ecache.c
+** Description: ReakoLite library on-disk encoded frame cache code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "ecache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_ECACHE_MUL 0x9E3779B97F4A7C15ULL
+#define RLS_ECACHE_NAME 24 /* "/" + 16 hex digits + ".rlc"/".tmp" + NUL */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Mix
+**
+** Description:
+**     Mixes 64 bits into a key, multiplying carries them up and the shift
+**     brings them back down
+**
+** Input:
+**     nHash - Key so far
+**     nValue - Bits to add
+**
+** Output:
+**     none
+**
+** Return value:
+**     New key
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint64_t RLS_ECache_Mix(uint64_t nHash, uint64_t nValue)
+{
+	nHash = (nHash ^ nValue) * RLS_ECACHE_MUL;
+	return nHash ^ (nHash >> 29);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Name
+**
+** Description:
+**     Makes the file name of an entry
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Key
+**     pszExt - Extension
+**
+** Output:
+**     File name in ptCache->pszPath
+**
+** Return value:
+**     File name
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static const char* RLS_ECache_Name(RLSECache_T* ptCache, uint64_t nKey,
+								   const char* pszExt)
+{
+	sprintf(ptCache->pszPath + ptCache->nDirLen, "/%08lX%08lX.%s",
+			(unsigned long)(nKey >> 32), (unsigned long)(nKey & 0xFFFFFFFF),
+			pszExt);
+	return ptCache->pszPath;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Open
+**
+** Description:
+**     Sets up a cache in an existing directory
+**
+** Input:
+**     ptCache - Cache
+**     pszDir - Directory
+**
+** Output:
+**     Cache
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_ECache_Open(RLSECache_T* ptCache, const char* pszDir)
+{
+	if (!ptCache)
+		return false;
+	memset(ptCache, 0, sizeof(RLSECache_T));
+	if (!pszDir || !*pszDir)
+		return false;
+	ptCache->nDirLen = strlen(pszDir);
+	ptCache->pszPath = (char*)malloc(ptCache->nDirLen + RLS_ECACHE_NAME);
+	if (!ptCache->pszPath)
+		return false;
+	memcpy(ptCache->pszPath, pszDir, ptCache->nDirLen + 1);
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Close
+**
+** Description:
+**     Frees a cache, the entries stay on disk
+**
+** Input:
+**     ptCache - Cache
+**
+** Output:
+**     Cleared cache
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_ECache_Close(RLSECache_T* ptCache)
+{
+	if (!ptCache)
+		return;
+	free(ptCache->pszPath);
+	memset(ptCache, 0, sizeof(RLSECache_T));
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Key
+**
+** Description:
+**     Makes the key of a frame from its pixels, the encoder parameters and
+**     RLS_ECACHE_VERSION. Pixels are taken four at a time.
+**
+** Input:
+**     pPixels - RGB565 frame
+**     nWidth - Width
+**     nHeight - Height
+**     nStride - Row stride in pixels
+**     anParms - Encoder parameters
+**     nParms - Encoder parameter count
+**
+** Output:
+**     none
+**
+** Return value:
+**     Key
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint64_t RLS_ECache_Key(const uint16_t* pPixels, int nWidth, int nHeight,
+						int nStride, const uint32_t* anParms, int nParms)
+{
+	uint64_t nHash = RLS_ECache_Mix(RLS_ECACHE_MAGIC, RLS_ECACHE_VERSION);
+	uint64_t nQuad;
+	int nParm, nRow, nCol;
+
+	for (nParm = 0; nParm < nParms; nParm++)
+		nHash = RLS_ECache_Mix(nHash, anParms[nParm]);
+	nHash = RLS_ECache_Mix(nHash, ((uint64_t)nWidth << 32) | nHeight);
+	for (nRow = 0; nRow < nHeight; nRow++)
+	{
+		const uint16_t* pRow = pPixels + (size_t)nRow * nStride;
+		for (nCol = 0; nCol + 4 <= nWidth; nCol += 4)
+		{
+			memcpy(&nQuad, pRow + nCol, sizeof(nQuad));
+			nHash = RLS_ECache_Mix(nHash, nQuad);
+		}
+		for (; nCol < nWidth; nCol++)
+			nHash = RLS_ECache_Mix(nHash, pRow[nCol]);
+	}
+	/* final avalanche, so every input bit reaches the low bits too */
+	nHash ^= nHash >> 33;
+	nHash *= 0xFF51AFD7ED558CCDULL;
+	nHash ^= nHash >> 33;
+	return nHash;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Load
+**
+** Description:
+**     Reads an encoded frame. Entries of another version, key or shape
+**     count as misses.
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Key
+**     pOut - Encoded frame
+**     nMaxSize - Room in pOut
+**     pnExtra - Value stored with the frame
+**
+** Output:
+**     Encoded frame, value stored with it
+**
+** Return value:
+**     Encoded frame size/0 (miss)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_ECache_Load(RLSECache_T* ptCache, uint64_t nKey, uint8_t* pOut,
+						 uint32_t nMaxSize, int32_t* pnExtra)
+{
+	RLSECacheHeader_T tHeader;
+	FILE* pFile;
+	uint32_t nExtSize, nDataSize;
+	bool bOK;
+
+	if (!ptCache || !ptCache->pszPath)
+		return 0;
+	pFile = fopen(RLS_ECache_Name(ptCache, nKey, "rlc"), "rb");
+	bOK = pFile
+	   && fread(&tHeader, 1, sizeof(tHeader), pFile) == sizeof(tHeader)
+	   && tHeader.nMagic == RLS_ECACHE_MAGIC
+	   && tHeader.nVersion == RLS_ECACHE_VERSION && tHeader.nKey == nKey
+	   && tHeader.nSize <= nMaxSize
+	   && tHeader.nSize >= RLS_SPAL_SIZE * RLS_PAL_BYTES
+						   + 2 * sizeof(uint32_t)
+	   && fread(pOut, 1, tHeader.nSize, pFile) == tHeader.nSize
+	   && fgetc(pFile) == EOF;
+	if (pFile)
+		fclose(pFile);
+	if (bOK)
+	{
+		/* the frame must span the whole entry, a torn write does not */
+		memcpy(&nExtSize, pOut + RLS_SPAL_SIZE * RLS_PAL_BYTES,
+			   sizeof(uint32_t));
+		bOK = nExtSize <= RLS_EPAL_SIZE * RLS_PAL_BYTES
+		   && nExtSize <= tHeader.nSize - RLS_SPAL_SIZE * RLS_PAL_BYTES
+						  - 2 * sizeof(uint32_t);
+	}
+	if (bOK)
+	{
+		memcpy(&nDataSize, pOut + RLS_SPAL_SIZE * RLS_PAL_BYTES
+				+ sizeof(uint32_t) + nExtSize, sizeof(uint32_t));
+		bOK = nDataSize == tHeader.nSize - RLS_SPAL_SIZE * RLS_PAL_BYTES
+						   - 2 * sizeof(uint32_t) - nExtSize;
+	}
+	if (!bOK)
+	{
+		ptCache->nMisses++;
+		return 0;
+	}
+	ptCache->nHits++;
+	if (pnExtra)
+		*pnExtra = tHeader.nExtra;
+	return tHeader.nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_ECache_Store
+**
+** Description:
+**     Writes an encoded frame. The entry is written under a temporary name
+**     and renamed, so readers never see half of it.
+**
+** Input:
+**     ptCache - Cache
+**     nKey - Key
+**     pData - Encoded frame
+**     nSize - Encoded frame size
+**     nExtra - Value to keep with the frame
+**
+** Output:
+**     Entry file
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_ECache_Store(RLSECache_T* ptCache, uint64_t nKey,
+					  const uint8_t* pData, uint32_t nSize, int32_t nExtra)
+{
+	RLSECacheHeader_T tHeader;
+	char* pszTemp;
+	FILE* pFile;
+	bool bOK;
+
+	if (!ptCache || !ptCache->pszPath)
+		return false;
+	pszTemp = (char*)malloc(ptCache->nDirLen + RLS_ECACHE_NAME);
+	if (!pszTemp)
+		return false;
+	strcpy(pszTemp, RLS_ECache_Name(ptCache, nKey, "tmp"));
+	tHeader.nMagic = RLS_ECACHE_MAGIC;
+	tHeader.nVersion = RLS_ECACHE_VERSION;
+	tHeader.nKey = nKey;
+	tHeader.nSize = nSize;
+	tHeader.nExtra = nExtra;
+	pFile = fopen(pszTemp, "wb");
+	bOK = pFile
+	   && fwrite(&tHeader, 1, sizeof(tHeader), pFile) == sizeof(tHeader)
+	   && fwrite(pData, 1, nSize, pFile) == nSize;
+	if (pFile && fclose(pFile) != 0)
+		bOK = false;
+	if (bOK)
+	{
+		/* rename does not replace an existing file everywhere */
+		RLS_ECache_Name(ptCache, nKey, "rlc");
+		remove(ptCache->pszPath);
+		bOK = rename(pszTemp, ptCache->pszPath) == 0;
+	}
+	if (!bOK && pFile)
+		remove(pszTemp);
+	free(pszTemp);
+	if (bOK)
+		ptCache->nStored++;
+	return bOK;
+}
\ No newline at end of file
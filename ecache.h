@@ -0,0 +1,104 @@
+/*
+** ===========================================================================
+** File: ecache.h
+** Description: ReakoLite library on-disk encoded frame cache header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_ECACHE_H
+#define RLS_ECACHE_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+   Entry file <directory>/<key, 16 hex digits>.rlc, little-endian:
+   RLSECacheHeader_T
+   encoded frame (standard palette, extended palette, blocks)
+*/
+
+#define RLS_ECACHE_MAGIC 0x43454C52 //stored as 'RLEC'
+#define RLS_ECACHE_VERSION 1 /* bump whenever encoder output changes */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSECacheHeader_T RLSECacheHeader_T;
+typedef struct tagRLSECache_T RLSECache_T;
+
+#pragma pack(push)  /* push current alignment to stack */
+#pragma pack(1)     /* set alignment to 1 byte boundary */
+typedef struct tagRLSECacheHeader_T
+{
+	uint32_t nMagic;
+	uint32_t nVersion; /* RLS_ECACHE_VERSION */
+	uint64_t nKey;
+	uint32_t nSize; /* encoded frame size */
+	int32_t nExtra; /* caller value kept with the frame */
+};
+#pragma pack(pop)   /* restore original alignment from stack */
+
+/* cache directory */
+typedef struct tagRLSECache_T
+{
+	char* pszPath; /* directory, then room for an entry name */
+	size_t nDirLen;
+	uint32_t nHits;
+	uint32_t nMisses;
+	uint32_t nStored;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_ECache_Open(RLSECache_T* ptCache, const char* pszDir);
+extern void RLS_ECache_Close(RLSECache_T* ptCache);
+extern uint64_t RLS_ECache_Key(const uint16_t* pPixels, int nWidth,
+							   int nHeight, int nStride,
+							   const uint32_t* anParms, int nParms);
+extern uint32_t RLS_ECache_Load(RLSECache_T* ptCache, uint64_t nKey,
+								uint8_t* pOut, uint32_t nMaxSize,
+								int32_t* pnExtra);
+extern bool RLS_ECache_Store(RLSECache_T* ptCache, uint64_t nKey,
+							 const uint8_t* pData, uint32_t nSize,
+							 int32_t nExtra);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_ECACHE_H
\ No newline at end of file
@@ -0,0 +1,398 @@
+/*
+** ===========================================================================
+** File: edit.c
+** Description: ReakoLite library container editing code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check frames drawing over changed frames
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "decode.h"
+#include "edit.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_FrameSize
+**
+** Description:
+**     Gets the size of a frame from its palette and data sizes
+**
+** Input:
+**     pFrame - Frame, checked by RLS_Common_GetSize
+**
+** Output:
+**     none
+**
+** Return value:
+**     Frame size
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint32_t RLS_Edit_FrameSize(const uint8_t* pFrame)
+{
+	uint32_t nOffset = RLS_SPAL_SIZE * RLS_PAL_BYTES;
+	uint32_t nSize;
+	memcpy(&nSize, pFrame + nOffset, sizeof(uint32_t));
+	nOffset += sizeof(uint32_t) + nSize;
+	memcpy(&nSize, pFrame + nOffset, sizeof(uint32_t));
+	return nOffset + sizeof(uint32_t) + nSize;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_Init
+**
+** Description:
+**     Starts an empty container
+**
+** Input:
+**     ptEdit - Container
+**
+** Output:
+**     Empty container
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Edit_Init(RLSEdit_T* ptEdit)
+{
+	if (ptEdit)
+		memset(ptEdit, 0, sizeof(RLSEdit_T));
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_Insert
+**
+** Description:
+**     Inserts frames of another container, as they are encoded. The first
+**     frames inserted set the frame size, which deleting every frame does
+**     not reset.
+**
+** Input:
+**     ptEdit - Container
+**     nAt - Position, ptEdit->nFrames appends
+**     pData - Source container, kept until RLS_Edit_Write
+**     nSize - Source container size
+**     nFrom - First source frame
+**     nCount - Source frames (-1 - up to the last)
+**
+** Output:
+**     Container
+**
+** Return value:
+**     RLS_EDIT_OK/RLS_EDIT_E*
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Keep the first frame size, source predecessor
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Edit_Insert(RLSEdit_T* ptEdit, int nAt, const uint8_t* pData,
+					size_t nSize, int nFrom, int nCount)
+{
+	const uint8_t* pFrame;
+	const uint8_t* pPrev = NULL;
+	int nFrames = 0, nWidth = 0, nHeight = 0;
+	int nFrame;
+
+	if (!ptEdit || !pData || !RLS_Common_GetSize(pData, nSize))
+		return RLS_EDIT_EIMAGE;
+	RLS_Common_GetInfo((uint8_t*)pData, &nFrames, &nWidth, &nHeight, NULL);
+	if (ptEdit->nWidth
+	 && (nWidth != ptEdit->nWidth || nHeight != ptEdit->nHeight))
+		return RLS_EDIT_ESIZE;
+	if (nCount < 0)
+		nCount = nFrames - nFrom;
+	if (nAt < 0 || nAt > ptEdit->nFrames || nFrom < 0 || nCount <= 0
+	 || nCount > nFrames - nFrom)
+		return RLS_EDIT_ERANGE;
+	if (nCount > UINT8_MAX - ptEdit->nFrames)
+		return RLS_EDIT_EFRAMES;
+
+	memmove(&ptEdit->atFrames[nAt + nCount], &ptEdit->atFrames[nAt],
+			(ptEdit->nFrames - nAt) * sizeof(RLSEditFrame_T));
+	ptEdit->nFrames += nCount;
+	ptEdit->nWidth = nWidth;
+	ptEdit->nHeight = nHeight;
+	/* RLS_Common_GetSize has walked these already, sizes are sound */
+	pFrame = pData + 12;
+	for (nFrame = 0; nFrame < nFrom + nCount; nFrame++)
+	{
+		uint32_t nFrameSize = RLS_Edit_FrameSize(pFrame);
+		if (nFrame >= nFrom)
+		{
+			ptEdit->atFrames[nAt].pData = pFrame;
+			ptEdit->atFrames[nAt].nSize = nFrameSize;
+			ptEdit->atFrames[nAt++].pPrev = pPrev;
+		}
+		pPrev = pFrame;
+		pFrame += nFrameSize;
+	}
+	return RLS_EDIT_OK;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_Delete
+**
+** Description:
+**     Removes frames
+**
+** Input:
+**     ptEdit - Container
+**     nAt - First frame
+**     nCount - Frames
+**
+** Output:
+**     Container
+**
+** Return value:
+**     RLS_EDIT_OK/RLS_EDIT_ERANGE
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Edit_Delete(RLSEdit_T* ptEdit, int nAt, int nCount)
+{
+	if (!ptEdit || nAt < 0 || nCount <= 0 || nAt >= ptEdit->nFrames
+	 || nCount > ptEdit->nFrames - nAt)
+		return RLS_EDIT_ERANGE;
+	memmove(&ptEdit->atFrames[nAt], &ptEdit->atFrames[nAt + nCount],
+			(ptEdit->nFrames - nAt - nCount) * sizeof(RLSEditFrame_T));
+	ptEdit->nFrames -= nCount;
+	return RLS_EDIT_OK;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_Check
+**
+** Description:
+**     Checks the frames that now follow another frame than in their
+**     source. Alpha blocks keep the pixels of the frame before, so such a
+**     frame would show something else; it is decoded over two different
+**     backgrounds to find out whether it has any.
+**
+** Input:
+**     ptEdit - Container
+**     pnFrame - Frame that failed the check
+**
+** Output:
+**     pnFrame - First frame drawing over a frame the edit changed
+**
+** Return value:
+**     RLS_EDIT_OK/RLS_EDIT_EDEPEND/RLS_EDIT_EIMAGE/RLS_EDIT_EMEMORY
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Edit_Check(const RLSEdit_T* ptEdit, int* pnFrame)
+{
+	size_t nPixels, nMaxSize = 0;
+	uint16_t *pBlack, *pWhite;
+	uint8_t* pOne;
+	int nFrame, nResult = RLS_EDIT_OK;
+
+	if (!ptEdit || !pnFrame)
+		return RLS_EDIT_EEMPTY;
+	for (nFrame = 0; nFrame < ptEdit->nFrames; nFrame++)
+		if (ptEdit->atFrames[nFrame].nSize > nMaxSize)
+			nMaxSize = ptEdit->atFrames[nFrame].nSize;
+	nPixels = (size_t)ptEdit->nWidth * ptEdit->nHeight;
+	pBlack = (uint16_t*)malloc(nPixels * sizeof(uint16_t));
+	pWhite = (uint16_t*)malloc(nPixels * sizeof(uint16_t));
+	pOne = (uint8_t*)malloc(12 + nMaxSize);
+	if (!pBlack || !pWhite || !pOne)
+	{
+		free(pOne);
+		free(pWhite);
+		free(pBlack);
+		return RLS_EDIT_EMEMORY;
+	}
+	/* each frame is decoded alone, in a container of its own */
+	RLS_Common_MakeInfo(pOne, 1, ptEdit->nWidth, ptEdit->nHeight, 0, false);
+	for (nFrame = 0; nFrame < ptEdit->nFrames; nFrame++)
+	{
+		const RLSEditFrame_T* ptFrame = &ptEdit->atFrames[nFrame];
+		bool bSame = !ptFrame->pPrev;
+		if (nFrame)
+		{
+			/* the same frame may come from another copy of its source */
+			const RLSEditFrame_T* ptPrev = ptFrame - 1;
+			bSame = ptFrame->pPrev
+				 && RLS_Edit_FrameSize(ptFrame->pPrev) == ptPrev->nSize
+				 && memcmp(ptFrame->pPrev, ptPrev->pData, ptPrev->nSize) == 0;
+		}
+		if (bSame)
+			continue;
+		memcpy(pOne + 12, ptFrame->pData, ptFrame->nSize);
+		memset(pBlack, 0x00, nPixels * sizeof(uint16_t));
+		memset(pWhite, 0xFF, nPixels * sizeof(uint16_t));
+		if (!RLS_Decode(pOne, 12 + ptFrame->nSize, 0, pBlack,
+						ptEdit->nWidth)
+		 || !RLS_Decode(pOne, 12 + ptFrame->nSize, 0, pWhite,
+						ptEdit->nWidth))
+			nResult = RLS_EDIT_EIMAGE;
+		else if (memcmp(pBlack, pWhite, nPixels * sizeof(uint16_t)) != 0)
+			nResult = RLS_EDIT_EDEPEND;
+		if (nResult != RLS_EDIT_OK)
+		{
+			*pnFrame = nFrame;
+			break;
+		}
+	}
+	free(pOne);
+	free(pWhite);
+	free(pBlack);
+	return nResult;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Edit_Write
+**
+** Description:
+**     Writes the container: a new header, the frames as they are and a
+**     new frame index
+**
+** Input:
+**     ptEdit - Container
+**     pOut - Output file
+**     bIndex - Append a frame index
+**
+** Output:
+**     Container to pOut
+**
+** Return value:
+**     RLS_EDIT_OK/RLS_EDIT_EEMPTY/RLS_EDIT_EWRITE
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Edit_Write(const RLSEdit_T* ptEdit, FILE* pOut, bool bIndex)
+{
+	uint8_t abHeader[12] = {0};
+	uint8_t abIndex[RLS_INDEX_SIZE(UINT8_MAX)];
+	uint32_t anOffsets[UINT8_MAX];
+	uint32_t nOffset = sizeof(abHeader);
+	int nSavingCalcSize = 0;
+	int nFrame, nIndexSize;
+
+	if (!ptEdit || !ptEdit->nFrames)
+		return RLS_EDIT_EEMPTY;
+	for (nFrame = 0; nFrame < ptEdit->nFrames; nFrame++)
+	{
+		anOffsets[nFrame] = nOffset;
+		nOffset += ptEdit->atFrames[nFrame].nSize;
+		nSavingCalcSize += ptEdit->atFrames[nFrame].nSize
+						 - (2 * sizeof(uint32_t));
+	}
+	/* the savings byte is worked out as the encoder does */
+	RLS_Common_MakeInfo(abHeader, ptEdit->nFrames, ptEdit->nWidth,
+		ptEdit->nHeight, RLS_CALC_SAVING((ptEdit->nWidth * ptEdit->nHeight
+		* ptEdit->nFrames), nSavingCalcSize), false);
+	if (fwrite(abHeader, 1, sizeof(abHeader), pOut) != sizeof(abHeader))
+		return RLS_EDIT_EWRITE;
+	for (nFrame = 0; nFrame < ptEdit->nFrames; nFrame++)
+		if (fwrite(ptEdit->atFrames[nFrame].pData, 1,
+				   ptEdit->atFrames[nFrame].nSize, pOut)
+			!= ptEdit->atFrames[nFrame].nSize)
+			return RLS_EDIT_EWRITE;
+	if (bIndex)
+	{
+		nIndexSize = RLS_Common_MakeIndex(abIndex, anOffsets,
+										  ptEdit->nFrames);
+		if (fwrite(abIndex, 1, nIndexSize, pOut) != (size_t)nIndexSize)
+			return RLS_EDIT_EWRITE;
+	}
+	return RLS_EDIT_OK;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+** ===========================================================================
+** File: edit.h
+** Description: ReakoLite library container editing header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Check frames drawing over changed frames
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_EDIT_H
+#define RLS_EDIT_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_EDIT_OK 0
+#define RLS_EDIT_EIMAGE 1 /* not an RLS container */
+#define RLS_EDIT_ESIZE 2 /* frames of another size */
+#define RLS_EDIT_EFRAMES 3 /* more than UINT8_MAX frames */
+#define RLS_EDIT_ERANGE 4 /* no such frame */
+#define RLS_EDIT_EEMPTY 5 /* no frames left to write */
+#define RLS_EDIT_EWRITE 6 /* container could not be written */
+#define RLS_EDIT_EDEPEND 7 /* frame draws over a frame the edit changed */
+#define RLS_EDIT_EMEMORY 8 /* out of memory */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSEditFrame_T RLSEditFrame_T;
+typedef struct tagRLSEdit_T RLSEdit_T;
+
+/* encoded frame (palettes and blocks) inside a source container */
+typedef struct tagRLSEditFrame_T
+{
+	const uint8_t* pData;
+	uint32_t nSize;
+	const uint8_t* pPrev; /* frame before it in the source, NULL - none */
+};
+
+/* container being put together from the frames of others, which must stay
+   in memory until it is written */
+typedef struct tagRLSEdit_T
+{
+	RLSEditFrame_T atFrames[UINT8_MAX];
+	int nFrames;
+	int nWidth;
+	int nHeight;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern void RLS_Edit_Init(RLSEdit_T* ptEdit);
+extern int RLS_Edit_Insert(RLSEdit_T* ptEdit, int nAt, const uint8_t* pData,
+						   size_t nSize, int nFrom, int nCount);
+extern int RLS_Edit_Delete(RLSEdit_T* ptEdit, int nAt, int nCount);
+extern int RLS_Edit_Check(const RLSEdit_T* ptEdit, int* pnFrame);
+extern int RLS_Edit_Write(const RLSEdit_T* ptEdit, FILE* pOut, bool bIndex);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_EDIT_H
\ No newline at end of file
@@ -6,6 +6,14 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Report pixels changed by the palette fallback
+** 10/18/2026	agent			Clamp the snapping tolerance
+** 10/18/2026	agent			Snapping tolerance getter
+** 10/18/2026	agent			Encoder state per thread
+** 10/18/2026	agent			Keep the extended palette within its size
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Standard palette snapping, lookup table
+** 10/18/2026	agent			Preset standard palette
 ** 08/25/2024	raulmrio28-git	Initial version
 ** ===========================================================================
 */
@@ -20,6 +28,7 @@
 #include "common.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <memory.h>
 
 /*
@@ -31,6 +40,9 @@
 #define RLS_BKI_PU_WB(v, i, n) (v |= ((i&1)<<(3-n)))
 #define RLS_BKI_BI_WB(v, i, n) (v |= ((i&3)<<((3-n)<<1)))
 
+#define RLS_SPAL_MAP_SIZE (UINT16_MAX + 1)
+#define RLS_SPAL_MAP_NONE 0xffff /* not looked up yet */
+
 #define RLS_COPY(d, s, sz) memcpy(d, s, sz), d+=sz
 #define RLS_WRITESZ(d, n) \
 		{ \
@@ -56,6 +68,19 @@
 **----------------------------------------------------------------------------
 */
 
+static RLS_TLS uint16_t RLS_Encode_PresetPal[RLS_SPAL_SIZE];
+static RLS_TLS int RLS_Encode_PresetCols = 0;
+
+/*
+   Color -> standard palette index of the current frame. Entries point to
+   the color itself, to the palette color it snaps to, or hold
+   RLS_SPAL_SIZE (extended palette) / RLS_SPAL_MAP_NONE (not looked up).
+*/
+static RLS_TLS uint16_t RLS_Encode_SPalMap[RLS_SPAL_MAP_SIZE];
+static RLS_TLS int RLS_Encode_SnapTol = 0;
+/* pixels of the last frame changed because the extended palette was full */
+static RLS_TLS uint32_t RLS_Encode_Lossy = 0;
+
 /*
 **----------------------------------------------------------------------------
 **  Function(internal use only) Declarations
@@ -127,13 +152,140 @@ void RLS_Encode_MoveMem(uint8_t* pData, int nSize, int nOffset)
 */
 uint16_t RLS_Encode_ColInSPal(uint16_t wColor)
 {
-	int nOffset;
-	for (nOffset = 0; nOffset < RLS_SPAL_SIZE; nOffset++)
-		if (wColor == RLS_Common_StdPal[nOffset])
-			return nOffset;
+	uint16_t nOffset = RLS_Encode_SPalMap[wColor];
+	if (nOffset < RLS_SPAL_SIZE && RLS_Common_StdPal[nOffset] == wColor)
+		return nOffset;
 	return RLS_SPAL_SIZE;
 }
 
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_MakeSPalMap
+**
+** Description:
+**     Builds the color lookup table of the standard palette
+**
+** Input:
+**     none
+**
+** Output:
+**     RLS_Encode_SPalMap
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Encode_MakeSPalMap(void)
+{
+	int nOffset;
+	memset(RLS_Encode_SPalMap, 0xff, sizeof(RLS_Encode_SPalMap));
+	/* backwards, so duplicated colors map to the first entry */
+	for (nOffset = RLS_SPAL_SIZE - 1; nOffset >= 0; nOffset--)
+		RLS_Encode_SPalMap[RLS_Common_StdPal[nOffset]] = nOffset;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_NearestIdx
+**
+** Description:
+**     Finds the standard palette color nearest to a color
+**
+** Input:
+**     wColor - RGB565 color
+**     bAlpha - alpha flag
+**     wAlpha - alpha color (never matched from or to)
+**     nMaxDiff - largest RLS_Common_ColorDiff accepted
+**
+** Output:
+**     none
+**
+** Return value:
+**     Standard palette index/RLS_SPAL_SIZE (nothing close enough)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Split out of RLS_Encode_SnapCol
+** ---------------------------------------------------------------------------
+*/
+
+uint16_t RLS_Encode_NearestIdx(uint16_t wColor, bool bAlpha, uint16_t wAlpha,
+							   int nMaxDiff)
+{
+	uint16_t nOffset = RLS_SPAL_SIZE;
+	int nBestDiff = nMaxDiff;
+	int nIdx;
+	if (bAlpha == true && wColor == wAlpha)
+		return nOffset;
+	for (nIdx = 0; nIdx < RLS_SPAL_SIZE; nIdx++)
+	{
+		int nDiff;
+		if (bAlpha == true && RLS_Common_StdPal[nIdx] == wAlpha)
+			continue;
+		nDiff = RLS_Common_ColorDiff(wColor, RLS_Common_StdPal[nIdx]);
+		if (nDiff <= nBestDiff && (nOffset == RLS_SPAL_SIZE
+		 || nDiff < nBestDiff))
+		{
+			nBestDiff = nDiff;
+			nOffset = nIdx;
+		}
+	}
+	return nOffset;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_SnapCol
+**
+** Description:
+**     Snaps a color missing from the standard palette to the nearest
+**     standard palette color within the snapping tolerance. Lookups are
+**     cached in RLS_Encode_SPalMap, so each color is searched once.
+**
+** Input:
+**     wColor - RGB565 color
+**     bAlpha - alpha flag
+**     wAlpha - alpha color (never snapped from or to)
+**
+** Output:
+**     none
+**
+** Return value:
+**     Snapped color/wColor
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Nearest color search split out
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint16_t RLS_Encode_SnapCol(uint16_t wColor, bool bAlpha, uint16_t wAlpha)
+{
+	uint16_t nOffset = RLS_Encode_SPalMap[wColor];
+	if (nOffset == RLS_SPAL_MAP_NONE)
+	{
+		nOffset = RLS_Encode_NearestIdx(wColor, bAlpha, wAlpha,
+										RLS_DIFF_MAX(RLS_Encode_SnapTol));
+		RLS_Encode_SPalMap[wColor] = nOffset;
+	}
+	return (nOffset < RLS_SPAL_SIZE) ? RLS_Common_StdPal[nOffset] : wColor;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 **
@@ -310,6 +462,7 @@ void RLS_Encode_MakeSPal_Undup(uint16_t* pRow, int* pnSize) {
 **     pIn - input data
 **     nWidth - image width
 **     nHeight - image height
+**     nStride - image row stride in pixels
 **
 ** Output:
 **     Built palette
@@ -320,11 +473,12 @@ void RLS_Encode_MakeSPal_Undup(uint16_t* pRow, int* pnSize) {
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 08/26/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
-bool RLS_Encode_MakeSPal(uint16_t* pIn, int nWidth, int nHeight)
+bool RLS_Encode_MakeSPal(uint16_t* pIn, int nWidth, int nHeight, int nStride)
 {
 	uint16_t* pTmpRow;
 	int nCols = RLS_CEIL(nWidth, 2);
@@ -345,16 +499,17 @@ bool RLS_Encode_MakeSPal(uint16_t* pIn, int nWidth, int nHeight)
 		for (nCurrCol = 0; nCurrCol < nCols; nCurrCol++)
 		{
 			if (RLS_Common_ExtractBlock(pIn, nWidth,
-				nHeight, nCurrCol, nCurrRow) == false)
+				nHeight, nStride, nCurrCol, nCurrRow) == false)
 				return 0;
 			pTmpRow[nSize++] = RLS_Common_Block[0];
 		}
 		RLS_Encode_MakeSPal_Sort(pTmpRow, nSize);
 		RLS_Encode_MakeSPal_Undup(pTmpRow, &nSize);
-		memcpy(&RLS_Common_StdPal[nPalOffset], pTmpRow, ((nSize < RLS_SPAL_SIZE)
-			? nSize : (RLS_SPAL_SIZE-nPalOffset)) << 1);
-		nPalOffset += ((nSize < RLS_SPAL_SIZE)
-					? nSize : (RLS_SPAL_SIZE - nPalOffset));
+		/* never copy past the end of the palette */
+		if (nSize > RLS_SPAL_SIZE - nPalOffset)
+			nSize = RLS_SPAL_SIZE - nPalOffset;
+		memcpy(&RLS_Common_StdPal[nPalOffset], pTmpRow, nSize << 1);
+		nPalOffset += nSize;
 		if (nPalOffset >= RLS_SPAL_SIZE)
 			break;
 	}
@@ -471,6 +626,146 @@ uint32_t RLS_Encode_EncodeBlk(uint16_t* pIn, bool bAlpha, uint16_t wAlpha,
 **----------------------------------------------------------------------------
 */
 
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_SetSPal
+**
+** Description:
+**     Sets a standard palette to use instead of building one from the image
+**     (e.g. from RLS_Quantize_Palette)
+**
+** Input:
+**     pPal - palette, NULL to build it from the image again
+**     nColors - palette size (up to RLS_SPAL_SIZE)
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Encode_SetSPal(uint16_t* pPal, int nColors)
+{
+	if (!pPal || nColors <= 0)
+	{
+		RLS_Encode_PresetCols = 0;
+		return;
+	}
+	if (nColors > RLS_SPAL_SIZE)
+		nColors = RLS_SPAL_SIZE;
+	memcpy(RLS_Encode_PresetPal, pPal, nColors * RLS_PAL_BYTES);
+	RLS_Encode_PresetCols = nColors;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_SetSnap
+**
+** Description:
+**     Sets the standard palette snapping tolerance. Pixels missing from the
+**     standard palette are replaced with the nearest standard palette color
+**     within the tolerance instead of going to the extended palette.
+**
+** Input:
+**     nTolerance - per-channel tolerance in 8-bit scale (0 - off, at
+**                  most RLS_DIFF_TOL_MAX)
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Clamp the tolerance
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Encode_SetSnap(int nTolerance)
+{
+	/* larger tolerances would overflow RLS_DIFF_MAX */
+	if (nTolerance > RLS_DIFF_TOL_MAX)
+		nTolerance = RLS_DIFF_TOL_MAX;
+	RLS_Encode_SnapTol = (nTolerance > 0) ? nTolerance : 0;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_GetSnap
+**
+** Description:
+**     Gets the standard palette snapping tolerance of this thread
+**
+** Input:
+**     none
+**
+** Output:
+**     none
+**
+** Return value:
+**     per-channel tolerance in 8-bit scale (0 - off)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Encode_GetSnap(void)
+{
+	return RLS_Encode_SnapTol;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Encode_GetLossy
+**
+** Description:
+**     Gets how many pixels the last RLS_Encode of this thread changed to
+**     the nearest standard palette color because the extended palette was
+**     full. Block pixels are counted, so a pixel repeated at an odd edge
+**     counts twice.
+**
+** Input:
+**     none
+**
+** Output:
+**     none
+**
+** Return value:
+**     Changed pixels (0 - lossless, apart from quantizing and snapping)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Encode_GetLossy(void)
+{
+	return RLS_Encode_Lossy;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 **
@@ -487,22 +782,26 @@ uint32_t RLS_Encode_EncodeBlk(uint16_t* pIn, bool bAlpha, uint16_t wAlpha,
 **     wAlpha - alpha color
 **     nWidth - image width
 **     nHeight - image height
+**     nStride - image row stride in pixels (at least nWidth)
 **
 ** Output:
-**     Encoded image to pOut
+**     Encoded image to pOut, pixels changed (RLS_Encode_GetLossy)
 **
 ** Return value:
-**     nDataOffs+nDataSize
+**     nDataOffs+nDataSize/0 (extended palette full in a block with alpha)
 **
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Count the pixels the fallback changes
+** 10/18/2026	agent			Standard palette fallback when extended is full
+** 10/18/2026	agent			Row stride
 ** 08/25/2024	raulmrio28-git	Initial version
 ** ---------------------------------------------------------------------------
 */
 
 uint32_t RLS_Encode(uint16_t* pIn,uint8_t* pOut,bool bAlpha,uint16_t wAlpha,
-					int nWidth, int nHeight)
+					int nWidth, int nHeight, int nStride)
 {
 	uint8_t* pCurrOutput = pOut;
 	uint8_t* pWriteOutput = pOut;
@@ -513,9 +812,18 @@ uint32_t RLS_Encode(uint16_t* pIn,uint8_t* pOut,bool bAlpha,uint16_t wAlpha,
 	int nCurrCol, nCurrRow;
 	bool doCalc = true;
 
-	if (!pOut)
+	RLS_Encode_Lossy = 0;
+	if (!pOut || nStride < nWidth)
 		return 0;
-	RLS_Encode_MakeSPal(pIn, nWidth, nHeight);
+	if (RLS_Encode_PresetCols > 0)
+	{
+		memset(RLS_Common_StdPal, 0, sizeof(RLS_Common_StdPal));
+		memcpy(RLS_Common_StdPal, RLS_Encode_PresetPal,
+			   RLS_Encode_PresetCols * RLS_PAL_BYTES);
+	}
+	else
+		RLS_Encode_MakeSPal(pIn, nWidth, nHeight, nStride);
+	RLS_Encode_MakeSPalMap();
 	RLS_Common_ExtPal_CIdx = 0;
  	for (nCurrRow = 0; nCurrRow < nRows; nCurrRow++)
 	{
@@ -523,8 +831,35 @@ uint32_t RLS_Encode(uint16_t* pIn,uint8_t* pOut,bool bAlpha,uint16_t wAlpha,
 		{
 			int nBkSize;
 			if (RLS_Common_ExtractBlock(pIn, nWidth,
-				nHeight, nCurrCol, nCurrRow) == false)
+				nHeight, nStride, nCurrCol, nCurrRow) == false)
 				return 0;
+			if (RLS_Encode_SnapTol > 0)
+			{
+				int nBkPix;
+				for (nBkPix = 0; nBkPix < 2*2; nBkPix++)
+					RLS_Common_Block[nBkPix] = RLS_Encode_SnapCol(
+						RLS_Common_Block[nBkPix], bAlpha, wAlpha);
+			}
+			if (RLS_Common_ExtPal_CIdx > RLS_EPAL_SIZE - 2*2)
+			{
+				/* extended palette is full, the rest of the frame makes
+				   do with the nearest standard palette colors */
+				int nBkPix;
+				if (bAlpha == true
+				 && RLS_Encode_ColInBlk(RLS_Common_Block, wAlpha) == true)
+					return 0;
+				for (nBkPix = 0; nBkPix < 2*2; nBkPix++)
+				{
+					uint16_t nIdx = RLS_Encode_NearestIdx(
+						RLS_Common_Block[nBkPix], bAlpha, wAlpha, INT_MAX);
+					if (nIdx < RLS_SPAL_SIZE
+					 && RLS_Common_Block[nBkPix] != RLS_Common_StdPal[nIdx])
+					{
+						RLS_Common_Block[nBkPix] = RLS_Common_StdPal[nIdx];
+						RLS_Encode_Lossy++;
+					}
+				}
+			}
 			nBkSize = RLS_Encode_EncodeBlk(RLS_Common_Block, bAlpha,
 										   wAlpha, pCurrOutput);
 			nDataSize += nBkSize;
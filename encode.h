@@ -6,6 +6,10 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Report pixels changed by the palette fallback
+** 10/18/2026	agent			Snapping tolerance getter
+** 10/18/2026	agent			Encoded frame size macro
+** 10/18/2026	agent			Row stride parameters
 ** 08/23/2024	raulmrio28-git	Initial version
 ** ===========================================================================
 */
@@ -32,6 +36,11 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
+/* worst case size of one encoded frame */
+#define RLS_ENCODE_BSIZE(nWidth, nHeight) \
+	(2*sizeof(uint32_t)+(RLS_EPAL_SIZE*(RLS_PAL_BYTES+RLS_SPAL_SIZE)) \
+	+((nWidth*nHeight*5)/4))
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -51,7 +60,12 @@ extern "C" {
 */
 
 extern uint32_t RLS_Encode(uint16_t* pIn, uint8_t* pOut, bool bAlpha,
-						   uint16_t wAlpha, int nWidth, int nHeight);
+						   uint16_t wAlpha, int nWidth, int nHeight,
+						   int nStride);
+extern void RLS_Encode_SetSPal(uint16_t* pPal, int nColors);
+extern void RLS_Encode_SetSnap(int nTolerance);
+extern int RLS_Encode_GetSnap(void);
+extern uint32_t RLS_Encode_GetLossy(void);
 
 #ifdef __cplusplus
 } /* extern "C" */
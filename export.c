@@ -0,0 +1,629 @@
+/*
+** ===========================================================================
+** File: export.c
+** Description: ReakoLite library frame export code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Raw frame stream export
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "convert.h"
+#include "decode.h"
+#include "export.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+   Pipeline: the caller decodes frames in order into a canvas (transparent
+   blocks keep the previous frame's pixels, so decoding stays sequential)
+   and copies each one into a free slot of a ring; worker threads take the
+   slots in frame order and write the PNGs.
+*/
+
+#define RLS_EXPORT_SLOTS_EXTRA 2 /* slots beyond one per worker */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSExportSlot_T RLSExportSlot_T;
+
+typedef struct tagRLSExportSlot_T
+{
+	RGB565_T* pImg;
+	bool bFull;
+};
+
+typedef struct tagRLSExport_T RLSExport_T;
+
+typedef struct tagRLSExport_T
+{
+	const char* pszBase;
+	int nWidth;
+	int nHeight;
+	RLS_Mutex_T tMutex;
+	RLS_Cond_T tReady; /* a frame was produced or production ended */
+	RLS_Cond_T tFree; /* a slot was released */
+	RLSExportSlot_T* atSlots;
+	int nSlots;
+	int nProduced; /* frames in slots so far */
+	int nNext; /* next frame for a worker */
+	bool bDone; /* no more frames will be produced */
+	int nResult; /* RLS_EXPORT_* */
+	int nFailed; /* first failed frame */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_WriteFrame
+**
+** Description:
+**     Writes a frame to <base>_<frame>.png
+**
+** Input:
+**     pszBase - Base file name
+**     pImg - Frame
+**     nWidth - Width
+**     nHeight - Height
+**     nFrame - Frame number
+**
+** Output:
+**     PNG file
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Export_WriteFrame(const char* pszBase, RGB565_T* pImg,
+								  int nWidth, int nHeight, int nFrame)
+{
+	char* pszFn = (char*)malloc(strlen(pszBase) + 16);
+	bool bResult;
+	if (!pszFn)
+		return false;
+	sprintf(pszFn, "%s_%d.png", pszBase, nFrame);
+	bResult = RLS_Convert_565toPNG(pImg, pszFn, nWidth, nHeight);
+	free(pszFn);
+	return bResult;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_Fail
+**
+** Description:
+**     Records a failure (the earliest frame wins) and wakes every thread
+**     so the pipeline winds down. Called with the mutex held.
+**
+** Input:
+**     ptExp - Export state
+**     nResult - RLS_EXPORT_* error
+**     nFrame - Failed frame
+**
+** Output:
+**     Export state
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Export_Fail(RLSExport_T* ptExp, int nResult, int nFrame)
+{
+	if (ptExp->nResult == RLS_EXPORT_OK || nFrame < ptExp->nFailed)
+	{
+		ptExp->nResult = nResult;
+		ptExp->nFailed = nFrame;
+	}
+	RLS_Cond_Broadcast(&ptExp->tReady);
+	RLS_Cond_Broadcast(&ptExp->tFree);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_Worker
+**
+** Description:
+**     Writes produced frames in order until production ends (thread
+**     function)
+**
+** Input:
+**     pArg - Export state
+**
+** Output:
+**     PNG files
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Export_Worker(void* pArg)
+{
+	RLSExport_T* ptExp = (RLSExport_T*)pArg;
+	RLS_Mutex_Lock(&ptExp->tMutex);
+	for (;;)
+	{
+		RLSExportSlot_T* ptSlot;
+		int nFrame;
+		bool bOK;
+		while (ptExp->nNext >= ptExp->nProduced && !ptExp->bDone
+			&& ptExp->nResult == RLS_EXPORT_OK)
+			RLS_Cond_Wait(&ptExp->tReady, &ptExp->tMutex);
+		if (ptExp->nResult != RLS_EXPORT_OK
+		 || ptExp->nNext >= ptExp->nProduced)
+			break;
+		nFrame = ptExp->nNext++;
+		ptSlot = &ptExp->atSlots[nFrame % ptExp->nSlots];
+		RLS_Mutex_Unlock(&ptExp->tMutex);
+
+		bOK = RLS_Export_WriteFrame(ptExp->pszBase, ptSlot->pImg,
+									ptExp->nWidth, ptExp->nHeight, nFrame);
+
+		RLS_Mutex_Lock(&ptExp->tMutex);
+		ptSlot->bFull = false;
+		RLS_Cond_Broadcast(&ptExp->tFree);
+		if (!bOK)
+			RLS_Export_Fail(ptExp, RLS_EXPORT_ECONVERT, nFrame);
+	}
+	RLS_Mutex_Unlock(&ptExp->tMutex);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_Produce
+**
+** Description:
+**     Decodes every frame in order and hands it to the workers
+**
+** Input:
+**     ptExp - Export state
+**     pData - RLS file
+**     nSize - RLS file size
+**     nFrames - Frame count
+**     pCanvas - Decode buffer
+**
+** Output:
+**     Filled slots
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Export_Produce(RLSExport_T* ptExp, uint8_t* pData,
+							   size_t nSize, int nFrames, RGB565_T* pCanvas)
+{
+	size_t nFrameSize = (size_t)ptExp->nWidth * ptExp->nHeight
+					  * sizeof(RGB565_T);
+	int nFrame;
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		RLSExportSlot_T* ptSlot = &ptExp->atSlots[nFrame % ptExp->nSlots];
+		bool bOK = RLS_Decode(pData, nSize, nFrame, pCanvas,
+							  ptExp->nWidth);
+
+		RLS_Mutex_Lock(&ptExp->tMutex);
+		if (!bOK)
+			RLS_Export_Fail(ptExp, RLS_EXPORT_EDECODE, nFrame);
+		while (ptSlot->bFull && ptExp->nResult == RLS_EXPORT_OK)
+			RLS_Cond_Wait(&ptExp->tFree, &ptExp->tMutex);
+		if (ptExp->nResult != RLS_EXPORT_OK)
+		{
+			RLS_Mutex_Unlock(&ptExp->tMutex);
+			break;
+		}
+		RLS_Mutex_Unlock(&ptExp->tMutex);
+
+		/* the slot is not visible to workers until nProduced moves */
+		memcpy(ptSlot->pImg, pCanvas, nFrameSize);
+
+		RLS_Mutex_Lock(&ptExp->tMutex);
+		ptSlot->bFull = true;
+		ptExp->nProduced++;
+		RLS_Cond_Signal(&ptExp->tReady);
+		RLS_Mutex_Unlock(&ptExp->tMutex);
+	}
+	RLS_Mutex_Lock(&ptExp->tMutex);
+	ptExp->bDone = true;
+	RLS_Cond_Broadcast(&ptExp->tReady);
+	RLS_Mutex_Unlock(&ptExp->tMutex);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_PackFrame
+**
+** Description:
+**     Converts a frame to a stream format, header included
+**
+** Input:
+**     pImg - Frame
+**     nWidth - Width
+**     nHeight - Height
+**     eFormat - Stream format
+**     pOut - Output buffer, at least nWidth * nHeight * 4 + 64 bytes
+**
+** Output:
+**     Packed frame
+**
+** Return value:
+**     Packed size in bytes
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static size_t RLS_Export_PackFrame(RGB565_T* pImg, int nWidth, int nHeight,
+								   RLS_EXPF_E eFormat, uint8_t* pOut)
+{
+	size_t nPixels = (size_t)nWidth * nHeight;
+	size_t nHdr = 0, nPix;
+	uint8_t* pPix;
+
+	if (eFormat == RLS_EXPF_PPM)
+		nHdr = sprintf((char*)pOut, "P6\n%d %d\n255\n", nWidth, nHeight);
+	else if (eFormat == RLS_EXPF_PAM)
+		nHdr = sprintf((char*)pOut, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 3\n"
+					   "MAXVAL 255\nTUPLTYPE RGB\nENDHDR\n", nWidth, nHeight);
+	pPix = pOut + nHdr;
+
+	if (eFormat == RLS_EXPF_RGB565)
+	{
+		for (nPix = 0; nPix < nPixels; nPix++)
+		{
+			pPix[nPix * 2] = (uint8_t)pImg[nPix];
+			pPix[nPix * 2 + 1] = (uint8_t)(pImg[nPix] >> 8);
+		}
+		return nHdr + nPixels * 2;
+	}
+	/* RGB888_T keeps the bytes in R, G, B order */
+	RLS_Convert_565to888(pImg, (RGB888_T*)pPix, nWidth, nHeight);
+	if (eFormat != RLS_EXPF_RGBA)
+		return nHdr + nPixels * 3;
+	/* widen in place from the end, pixel n moves from 3n to 4n */
+	for (nPix = nPixels; nPix-- > 0;)
+	{
+		pPix[nPix * 4 + 3] = 0xFF;
+		pPix[nPix * 4 + 2] = pPix[nPix * 3 + 2];
+		pPix[nPix * 4 + 1] = pPix[nPix * 3 + 1];
+		pPix[nPix * 4] = pPix[nPix * 3];
+	}
+	return nHdr + nPixels * 4;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_Pipeline
+**
+** Description:
+**     Runs the decode -> PNG pipeline with worker threads
+**
+** Input:
+**     ptExp - Export state, slots allocated
+**     pData - RLS file
+**     nSize - RLS file size
+**     nFrames - Frame count
+**     pCanvas - Decode buffer
+**     nWorkers - Worker count
+**
+** Output:
+**     PNG files, result in the export state
+**
+** Return value:
+**     false if no worker could be started (nothing was done)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Export_Pipeline(RLSExport_T* ptExp, uint8_t* pData,
+								size_t nSize, int nFrames,
+								RGB565_T* pCanvas, int nWorkers)
+{
+	RLS_Thread_T atThreads[RLS_THREAD_MAX];
+	RGB888_T tPix;
+	int nStarted = 0, nThread;
+
+	/* pick the conversion kernels before the workers race to do it */
+	RLS_Convert_565to888(pCanvas, &tPix, 1, 1);
+
+	if (!RLS_Mutex_Init(&ptExp->tMutex))
+		return false;
+	if (!RLS_Cond_Init(&ptExp->tReady))
+	{
+		RLS_Mutex_Destroy(&ptExp->tMutex);
+		return false;
+	}
+	if (!RLS_Cond_Init(&ptExp->tFree))
+	{
+		RLS_Cond_Destroy(&ptExp->tReady);
+		RLS_Mutex_Destroy(&ptExp->tMutex);
+		return false;
+	}
+	for (nThread = 0; nThread < nWorkers; nThread++)
+		if (RLS_Thread_Create(&atThreads[nStarted], RLS_Export_Worker,
+							  ptExp))
+			nStarted++;
+	if (nStarted)
+	{
+		RLS_Export_Produce(ptExp, pData, nSize, nFrames, pCanvas);
+		for (nThread = 0; nThread < nStarted; nThread++)
+			RLS_Thread_Join(atThreads[nThread]);
+	}
+	RLS_Cond_Destroy(&ptExp->tFree);
+	RLS_Cond_Destroy(&ptExp->tReady);
+	RLS_Mutex_Destroy(&ptExp->tMutex);
+	return nStarted > 0;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_PNGs
+**
+** Description:
+**     Writes every frame of an RLS file to <base>_<frame>.png. With more
+**     than one worker, decoding runs on the calling thread while the
+**     workers compress earlier frames.
+**
+** Input:
+**     pData - RLS file
+**     nSize - RLS file size, 0 if unknown (frame index is not used)
+**     pszBase - Base file name
+**     nWorkers - PNG writer threads (1 - write on the calling thread)
+**     pnFrame - Failed frame pointer, may be NULL
+**
+** Output:
+**     PNG files, failed frame
+**
+** Return value:
+**     RLS_EXPORT_*
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Export_PNGs(uint8_t* pData, size_t nSize, const char* pszBase,
+					int nWorkers, int* pnFrame)
+{
+	RLSExport_T tExp;
+	RGB565_T* pCanvas;
+	int nFrames = 0, nFrame, nSlot;
+	bool bPiped = false;
+
+	memset(&tExp, 0, sizeof(tExp));
+	tExp.pszBase = pszBase;
+	if (!pData || !pszBase
+	 || RLS_Common_GetInfo(pData, &nFrames, &tExp.nWidth, &tExp.nHeight,
+						   NULL) < 0
+	 || nFrames <= 0)
+	{
+		if (pnFrame)
+			*pnFrame = 0;
+		return RLS_EXPORT_EDECODE;
+	}
+	/* blocks left transparent by the first frame stay black */
+	pCanvas = (RGB565_T*)calloc((size_t)tExp.nWidth * tExp.nHeight,
+								sizeof(RGB565_T));
+	if (!pCanvas)
+		return RLS_EXPORT_EMEM;
+
+	if (nWorkers > nFrames)
+		nWorkers = nFrames;
+	if (nWorkers > RLS_THREAD_MAX)
+		nWorkers = RLS_THREAD_MAX;
+	if (nWorkers > 1)
+	{
+		tExp.nSlots = nWorkers + RLS_EXPORT_SLOTS_EXTRA;
+		tExp.atSlots = (RLSExportSlot_T*)calloc(tExp.nSlots,
+												sizeof(RLSExportSlot_T));
+		for (nSlot = 0; tExp.atSlots && nSlot < tExp.nSlots; nSlot++)
+		{
+			tExp.atSlots[nSlot].pImg = (RGB565_T*)malloc(
+				(size_t)tExp.nWidth * tExp.nHeight * sizeof(RGB565_T));
+			if (!tExp.atSlots[nSlot].pImg)
+				break;
+		}
+		/* not enough memory for the ring: fall back to serial export */
+		if (tExp.atSlots && nSlot == tExp.nSlots)
+			bPiped = RLS_Export_Pipeline(&tExp, pData, nSize, nFrames,
+										 pCanvas, nWorkers);
+		for (nSlot = 0; tExp.atSlots && nSlot < tExp.nSlots; nSlot++)
+			free(tExp.atSlots[nSlot].pImg);
+		free(tExp.atSlots);
+	}
+	for (nFrame = 0; !bPiped && nFrame < nFrames; nFrame++)
+	{
+		if (!RLS_Decode(pData, nSize, nFrame, pCanvas, tExp.nWidth))
+		{
+			tExp.nResult = RLS_EXPORT_EDECODE;
+			tExp.nFailed = nFrame;
+			break;
+		}
+		if (!RLS_Export_WriteFrame(pszBase, pCanvas, tExp.nWidth,
+								   tExp.nHeight, nFrame))
+		{
+			tExp.nResult = RLS_EXPORT_ECONVERT;
+			tExp.nFailed = nFrame;
+			break;
+		}
+	}
+	free(pCanvas);
+	if (pnFrame)
+		*pnFrame = tExp.nFailed;
+	return tExp.nResult;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Export_Stream
+**
+** Description:
+**     Writes every frame of an RLS file to one stream (a file or stdout),
+**     uncompressed and back to back
+**
+** Input:
+**     pData - RLS file
+**     nSize - RLS file size, 0 if unknown (frame index is not used)
+**     pFile - Output stream, opened in binary mode
+**     eFormat - Stream format
+**     pnFrame - Failed frame pointer, may be NULL
+**
+** Output:
+**     Frame stream, failed frame
+**
+** Return value:
+**     RLS_EXPORT_*
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Export_Stream(uint8_t* pData, size_t nSize, FILE* pFile,
+					  RLS_EXPF_E eFormat, int* pnFrame)
+{
+	RGB565_T* pCanvas;
+	uint8_t* pOut;
+	int nFrames = 0, nWidth = 0, nHeight = 0, nFrame;
+	int nResult = RLS_EXPORT_OK;
+
+	if (pnFrame)
+		*pnFrame = 0;
+	if (!pData || !pFile
+	 || RLS_Common_GetInfo(pData, &nFrames, &nWidth, &nHeight, NULL) < 0
+	 || nFrames <= 0)
+		return RLS_EXPORT_EDECODE;
+	pCanvas = (RGB565_T*)calloc((size_t)nWidth * nHeight, sizeof(RGB565_T));
+	pOut = (uint8_t*)malloc((size_t)nWidth * nHeight * 4 + 64);
+	if (!pCanvas || !pOut)
+	{
+		free(pCanvas);
+		free(pOut);
+		return RLS_EXPORT_EMEM;
+	}
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		size_t nPacked;
+		if (!RLS_Decode(pData, nSize, nFrame, pCanvas, nWidth))
+		{
+			nResult = RLS_EXPORT_EDECODE;
+			break;
+		}
+		nPacked = RLS_Export_PackFrame(pCanvas, nWidth, nHeight, eFormat,
+									   pOut);
+		if (fwrite(pOut, 1, nPacked, pFile) != nPacked)
+		{
+			nResult = RLS_EXPORT_EWRITE;
+			break;
+		}
+	}
+	if (nResult == RLS_EXPORT_OK && fflush(pFile) != 0)
+	{
+		nResult = RLS_EXPORT_EWRITE;
+		nFrame = nFrames - 1;
+	}
+	if (pnFrame)
+		*pnFrame = nFrame;
+	free(pOut);
+	free(pCanvas);
+	return nResult;
+}
\ No newline at end of file
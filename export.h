@@ -0,0 +1,81 @@
+/*
+** ===========================================================================
+** File: export.h
+** Description: ReakoLite library frame export header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Raw frame stream export
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_EXPORT_H
+#define RLS_EXPORT_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_EXPORT_OK 0
+#define RLS_EXPORT_EMEM 1 /* out of memory */
+#define RLS_EXPORT_EDECODE 2 /* frame could not be decoded */
+#define RLS_EXPORT_ECONVERT 3 /* PNG could not be written */
+#define RLS_EXPORT_EWRITE 4 /* stream could not be written */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/* frame stream formats, every frame is written back to back */
+typedef enum tagRLS_EXPF_E
+{
+	RLS_EXPF_RGB565 = 0, /* 2 bytes per pixel, little-endian */
+	RLS_EXPF_RGB24 = 1, /* R, G, B */
+	RLS_EXPF_RGBA = 2, /* R, G, B, 255 */
+	RLS_EXPF_PPM = 3, /* binary PPM (P6) per frame */
+	RLS_EXPF_PAM = 4 /* PAM (P7) per frame, RGB tuples */
+} RLS_EXPF_E;
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern int RLS_Export_PNGs(uint8_t* pData, size_t nSize, const char* pszBase,
+						   int nWorkers, int* pnFrame);
+extern int RLS_Export_Stream(uint8_t* pData, size_t nSize, FILE* pFile,
+							 RLS_EXPF_E eFormat, int* pnFrame);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_EXPORT_H
\ No newline at end of file
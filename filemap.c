@@ -0,0 +1,189 @@
+/*
+** ===========================================================================
+** File: filemap.c
+** Description: ReakoLite library memory-mapped file code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "filemap.h"
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_FileMap_Open
+**
+** Description:
+**     Maps a whole file read-only into memory
+**
+** Input:
+**     ptMap - Mapping to fill in
+**     pszFn - File name
+**
+** Output:
+**     Mapping
+**
+** Return value:
+**     true/false (empty files cannot be mapped)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_FileMap_Open(RLSFileMap_T* ptMap, const char* pszFn)
+{
+#ifdef _WIN32
+	LARGE_INTEGER tSize;
+#else
+	struct stat tStat;
+	void* pView;
+	int nFd;
+#endif
+
+	if (!ptMap || !pszFn)
+		return false;
+	memset(ptMap, 0, sizeof(RLSFileMap_T));
+#ifdef _WIN32
+	ptMap->hFile = CreateFileA(pszFn, GENERIC_READ, FILE_SHARE_READ, NULL,
+							   OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+							   NULL);
+	if (ptMap->hFile == INVALID_HANDLE_VALUE)
+		return false;
+	if (GetFileSizeEx(ptMap->hFile, &tSize) && tSize.QuadPart > 0
+	 && (unsigned long long)tSize.QuadPart <= (size_t)-1)
+	{
+		ptMap->hMap = CreateFileMappingA(ptMap->hFile, NULL, PAGE_READONLY,
+										 0, 0, NULL);
+		if (ptMap->hMap)
+			ptMap->pData = (const uint8_t*)MapViewOfFile(ptMap->hMap,
+														 FILE_MAP_READ, 0,
+														 0, 0);
+	}
+	if (!ptMap->pData)
+	{
+		if (ptMap->hMap)
+			CloseHandle(ptMap->hMap);
+		CloseHandle(ptMap->hFile);
+		memset(ptMap, 0, sizeof(RLSFileMap_T));
+		return false;
+	}
+	ptMap->nSize = (size_t)tSize.QuadPart;
+#else
+	nFd = open(pszFn, O_RDONLY);
+	if (nFd < 0)
+		return false;
+	if (fstat(nFd, &tStat) != 0 || tStat.st_size <= 0
+	 || (unsigned long long)tStat.st_size > (size_t)-1)
+	{
+		close(nFd);
+		return false;
+	}
+	pView = mmap(NULL, (size_t)tStat.st_size, PROT_READ, MAP_PRIVATE, nFd, 0);
+	/* the mapping keeps the file referenced */
+	close(nFd);
+	if (pView == MAP_FAILED)
+		return false;
+#ifdef MADV_SEQUENTIAL
+	madvise(pView, (size_t)tStat.st_size, MADV_SEQUENTIAL);
+#endif
+	ptMap->pData = (const uint8_t*)pView;
+	ptMap->nSize = (size_t)tStat.st_size;
+#endif
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_FileMap_Close
+**
+** Description:
+**     Unmaps a file mapped with RLS_FileMap_Open
+**
+** Input:
+**     ptMap - Mapping
+**
+** Output:
+**     Cleared mapping
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_FileMap_Close(RLSFileMap_T* ptMap)
+{
+	if (!ptMap || !ptMap->pData)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(ptMap->pData);
+	CloseHandle(ptMap->hMap);
+	CloseHandle(ptMap->hFile);
+#else
+	munmap((void*)ptMap->pData, ptMap->nSize);
+#endif
+	memset(ptMap, 0, sizeof(RLSFileMap_T));
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+** ===========================================================================
+** File: filemap.h
+** Description: ReakoLite library memory-mapped file header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_FILEMAP_H
+#define RLS_FILEMAP_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSFileMap_T RLSFileMap_T;
+
+typedef struct tagRLSFileMap_T
+{
+	const uint8_t* pData; /* read-only view of the whole file */
+	size_t nSize;
+#ifdef _WIN32
+	HANDLE hFile;
+	HANDLE hMap;
+#endif
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_FileMap_Open(RLSFileMap_T* ptMap, const char* pszFn);
+extern void RLS_FileMap_Close(RLSFileMap_T* ptMap);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_FILEMAP_H
\ No newline at end of file
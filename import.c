@@ -0,0 +1,753 @@
+/*
+** ===========================================================================
+** File: import.c
+** Description: ReakoLite library uncompressed image import code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "import.h"
+#include "filemap.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+   Importers map the file and convert straight into the RGB565 buffer the
+   encoder works on (it quantizes in place, so the buffer is always a
+   copy). RGB565 data is little-endian, like the RLS data itself.
+*/
+
+#define RLS_BMP_FILEHDR 14 /* BITMAPFILEHEADER */
+#define RLS_BMP_INFOHDR 40 /* BITMAPINFOHEADER, older headers unsupported */
+#define RLS_BMP_MASKS (RLS_BMP_FILEHDR + RLS_BMP_INFOHDR) /* bit masks */
+#define RLS_BMP_RGB 0
+#define RLS_BMP_BITFIELDS 3
+#define RLS_BMP_ALPHABITFIELDS 6
+#define RLS_BMP_PAL_SIZE 256
+
+#define RLS_PNM_MAX_DIGITS 9
+
+#define RLS_IMPORT_PACK(r, g, b) \
+	((RGB565_T)((((r) >> 3) << 11) | (((g) >> 2) << 5) | ((b) >> 3)))
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSBMPMask_T RLSBMPMask_T;
+typedef struct tagRLSBMPInfo_T RLSBMPInfo_T;
+
+typedef struct tagRLSBMPMask_T
+{
+	uint32_t nMask;
+	int nShift;
+	int nBits;
+};
+
+typedef struct tagRLSBMPInfo_T
+{
+	int nWidth;
+	int nHeight;
+	bool bTopDown; /* rows stored top row first */
+	int nBpp;
+	size_t nStride; /* row size with padding */
+	size_t nOffset; /* pixel data offset */
+	RLSBMPMask_T atMask[3]; /* R, G, B for 16/32 bpp */
+	bool b565; /* 16 bpp RGB565, rows copied as they are */
+	RGB565_T awPal[RLS_BMP_PAL_SIZE]; /* 8 bpp color table */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_Get16 / RLS_Import_Get32
+**
+** Description:
+**     Reads a little-endian value
+**
+** Input:
+**     pData - Data
+**
+** Output:
+**     none
+**
+** Return value:
+**     Value
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint32_t RLS_Import_Get16(const uint8_t* pData)
+{
+	return pData[0] | (pData[1] << 8);
+}
+
+static uint32_t RLS_Import_Get32(const uint8_t* pData)
+{
+	return pData[0] | (pData[1] << 8) | (pData[2] << 16)
+		 | ((uint32_t)pData[3] << 24);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_MakeMask
+**
+** Description:
+**     Finds the position and width of a BMP channel bit mask
+**
+** Input:
+**     ptMask - Mask to fill in
+**     nMask - Bit mask
+**
+** Output:
+**     Mask
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Import_MakeMask(RLSBMPMask_T* ptMask, uint32_t nMask)
+{
+	ptMask->nMask = nMask;
+	ptMask->nShift = 0;
+	ptMask->nBits = 0;
+	if (!nMask)
+		return;
+	while (!((nMask >> ptMask->nShift) & 1))
+		ptMask->nShift++;
+	while (ptMask->nShift + ptMask->nBits < 32
+		&& ((nMask >> (ptMask->nShift + ptMask->nBits)) & 1))
+		ptMask->nBits++;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_MaskField
+**
+** Description:
+**     Extracts a channel from a BMP pixel and scales it to nBits
+**
+** Input:
+**     nPix - Pixel
+**     ptMask - Channel mask
+**     nBits - Target bits (at most 8)
+**
+** Output:
+**     none
+**
+** Return value:
+**     Channel value
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint32_t RLS_Import_MaskField(uint32_t nPix,
+									 const RLSBMPMask_T* ptMask, int nBits)
+{
+	uint32_t nVal;
+	if (!ptMask->nBits)
+		return 0;
+	nVal = (nPix & ptMask->nMask) >> ptMask->nShift;
+	if (ptMask->nBits >= nBits)
+		return nVal >> (ptMask->nBits - nBits);
+	return nVal * ((1u << nBits) - 1) / ((1u << ptMask->nBits) - 1);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_BMPInfo
+**
+** Description:
+**     Reads and validates the headers of a BMP file. Uncompressed 8, 16,
+**     24 and 32 bpp images with BITMAPINFOHEADER or later are supported.
+**
+** Input:
+**     ptMap - Mapped file
+**     ptInfo - Information to fill in
+**
+** Output:
+**     Image information
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Import_BMPInfo(const RLSFileMap_T* ptMap,
+							   RLSBMPInfo_T* ptInfo)
+{
+	const uint8_t* pData = ptMap->pData;
+	uint32_t nHdrSize, nCompression;
+	int32_t nWidth, nHeight;
+	uint64_t nEnd;
+
+	if (ptMap->nSize < RLS_BMP_MASKS || pData[0] != 'B' || pData[1] != 'M')
+		return false;
+	nHdrSize = RLS_Import_Get32(pData + 14);
+	nWidth = (int32_t)RLS_Import_Get32(pData + 18);
+	nHeight = (int32_t)RLS_Import_Get32(pData + 22);
+	ptInfo->nBpp = RLS_Import_Get16(pData + 28);
+	nCompression = RLS_Import_Get32(pData + 30);
+	if (nHdrSize < RLS_BMP_INFOHDR
+	 || nHdrSize > ptMap->nSize - RLS_BMP_FILEHDR
+	 || nWidth <= 0 || nHeight == 0 || nHeight == INT32_MIN)
+		return false;
+	ptInfo->nWidth = nWidth;
+	ptInfo->nHeight = (nHeight < 0) ? -nHeight : nHeight;
+	ptInfo->bTopDown = nHeight < 0;
+	ptInfo->nOffset = RLS_Import_Get32(pData + 10);
+
+	if (nCompression == RLS_BMP_BITFIELDS
+	 || nCompression == RLS_BMP_ALPHABITFIELDS)
+	{
+		/* right after BITMAPINFOHEADER or inside the later headers */
+		if ((ptInfo->nBpp != 16 && ptInfo->nBpp != 32)
+		 || ptMap->nSize < RLS_BMP_MASKS + 3 * sizeof(uint32_t))
+			return false;
+		RLS_Import_MakeMask(&ptInfo->atMask[0],
+							RLS_Import_Get32(pData + RLS_BMP_MASKS));
+		RLS_Import_MakeMask(&ptInfo->atMask[1],
+							RLS_Import_Get32(pData + RLS_BMP_MASKS + 4));
+		RLS_Import_MakeMask(&ptInfo->atMask[2],
+							RLS_Import_Get32(pData + RLS_BMP_MASKS + 8));
+	}
+	else if (nCompression != RLS_BMP_RGB)
+		return false;
+	else if (ptInfo->nBpp == 16)
+	{
+		/* X1R5G5B5 */
+		RLS_Import_MakeMask(&ptInfo->atMask[0], 0x7C00);
+		RLS_Import_MakeMask(&ptInfo->atMask[1], 0x03E0);
+		RLS_Import_MakeMask(&ptInfo->atMask[2], 0x001F);
+	}
+	else if (ptInfo->nBpp == 32)
+	{
+		RLS_Import_MakeMask(&ptInfo->atMask[0], 0xFF0000);
+		RLS_Import_MakeMask(&ptInfo->atMask[1], 0x00FF00);
+		RLS_Import_MakeMask(&ptInfo->atMask[2], 0x0000FF);
+	}
+	else if (ptInfo->nBpp == 8)
+	{
+		size_t nTable = RLS_BMP_FILEHDR + nHdrSize;
+		uint32_t nColors = RLS_Import_Get32(pData + 46);
+		uint32_t nColor;
+		if (nColors == 0 || nColors > RLS_BMP_PAL_SIZE)
+			nColors = RLS_BMP_PAL_SIZE;
+		if (nTable + nColors * 4 > ptMap->nSize)
+			return false;
+		/* out of range indices come out black */
+		memset(ptInfo->awPal, 0, sizeof(ptInfo->awPal));
+		for (nColor = 0; nColor < nColors; nColor++)
+		{
+			const uint8_t* pEntry = pData + nTable + nColor * 4;
+			ptInfo->awPal[nColor] = RLS_IMPORT_PACK(pEntry[2], pEntry[1],
+													pEntry[0]);
+		}
+	}
+	else if (ptInfo->nBpp != 24)
+		return false;
+
+	ptInfo->b565 = ptInfo->nBpp == 16 && ptInfo->atMask[0].nMask == 0xF800
+				&& ptInfo->atMask[1].nMask == 0x07E0
+				&& ptInfo->atMask[2].nMask == 0x001F;
+	ptInfo->nStride = (size_t)((((uint64_t)nWidth * ptInfo->nBpp + 31) / 32)
+							   * 4);
+	nEnd = ptInfo->nOffset + (uint64_t)ptInfo->nStride * ptInfo->nHeight;
+	return nEnd <= ptMap->nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_BMPRow
+**
+** Description:
+**     Converts one BMP row to RGB565
+**
+** Input:
+**     ptInfo - Image information
+**     pRow - Row data
+**     pDest - Destination row
+**
+** Output:
+**     Converted row
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Import_BMPRow(const RLSBMPInfo_T* ptInfo,
+							  const uint8_t* pRow, RGB565_T* pDest)
+{
+	int nX;
+	if (ptInfo->b565)
+	{
+		memcpy(pDest, pRow, (size_t)ptInfo->nWidth * sizeof(RGB565_T));
+		return;
+	}
+	switch (ptInfo->nBpp)
+	{
+	case 8:
+		for (nX = 0; nX < ptInfo->nWidth; nX++)
+			pDest[nX] = ptInfo->awPal[pRow[nX]];
+		break;
+	case 24:
+		/* stored B, G, R */
+		for (nX = 0; nX < ptInfo->nWidth; nX++, pRow += 3)
+			pDest[nX] = RLS_IMPORT_PACK(pRow[2], pRow[1], pRow[0]);
+		break;
+	default:
+		for (nX = 0; nX < ptInfo->nWidth; nX++)
+		{
+			uint32_t nPix = (ptInfo->nBpp == 16) ?
+							RLS_Import_Get16(pRow + nX * 2) :
+							RLS_Import_Get32(pRow + nX * 4);
+			pDest[nX] = (RGB565_T)(
+				(RLS_Import_MaskField(nPix, &ptInfo->atMask[0], 5) << 11)
+			  | (RLS_Import_MaskField(nPix, &ptInfo->atMask[1], 6) << 5)
+			  | RLS_Import_MaskField(nPix, &ptInfo->atMask[2], 5));
+		}
+		break;
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_PNMToken
+**
+** Description:
+**     Reads the next whitespace separated PNM header token, skipping
+**     comments
+**
+** Input:
+**     ptMap - Mapped file
+**     pnPos - Read position, moved past the token
+**     ppToken - Token pointer
+**     pnLen - Token length pointer
+**
+** Output:
+**     Token
+**
+** Return value:
+**     true/false (end of file)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Import_PNMToken(const RLSFileMap_T* ptMap, size_t* pnPos,
+								const char** ppToken, size_t* pnLen)
+{
+	const char* pData = (const char*)ptMap->pData;
+	size_t nPos = *pnPos;
+	for (;;)
+	{
+		while (nPos < ptMap->nSize && strchr(" \t\r\n\v\f", pData[nPos])
+			&& pData[nPos])
+			nPos++;
+		if (nPos >= ptMap->nSize || pData[nPos] != '#')
+			break;
+		while (nPos < ptMap->nSize && pData[nPos] != '\n')
+			nPos++;
+	}
+	*ppToken = pData + nPos;
+	while (nPos < ptMap->nSize && pData[nPos]
+		&& !strchr(" \t\r\n\v\f", pData[nPos]))
+		nPos++;
+	*pnLen = (pData + nPos) - *ppToken;
+	*pnPos = nPos;
+	return *pnLen > 0;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_PNMNumber
+**
+** Description:
+**     Reads a decimal PNM header value
+**
+** Input:
+**     ptMap - Mapped file
+**     pnPos - Read position, moved past the value
+**     pnVal - Value pointer
+**
+** Output:
+**     Value
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Import_PNMNumber(const RLSFileMap_T* ptMap, size_t* pnPos,
+								 int* pnVal)
+{
+	const char* pszToken;
+	size_t nLen, nIdx;
+	if (!RLS_Import_PNMToken(ptMap, pnPos, &pszToken, &nLen)
+	 || nLen > RLS_PNM_MAX_DIGITS)
+		return false;
+	*pnVal = 0;
+	for (nIdx = 0; nIdx < nLen; nIdx++)
+	{
+		if (pszToken[nIdx] < '0' || pszToken[nIdx] > '9')
+			return false;
+		*pnVal = *pnVal * 10 + (pszToken[nIdx] - '0');
+	}
+	return true;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_RawFrame
+**
+** Description:
+**     Converts a raw RGB565 (little-endian) or RGB24 (R, G, B) frame
+**
+** Input:
+**     pRaw - Raw frame
+**     nPixBytes - 2 for RGB565, 3 for RGB24
+**     pDest - Destination image
+**     nWidth - Width
+**     nHeight - Height
+**
+** Output:
+**     Converted image
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Import_RawFrame(const uint8_t* pRaw, int nPixBytes,
+						 RGB565_T* pDest, int nWidth, int nHeight)
+{
+	if (nPixBytes == sizeof(RGB565_T))
+		memcpy(pDest, pRaw, (size_t)nWidth * nHeight * sizeof(RGB565_T));
+	else
+		/* RGB888_T keeps the bytes in R, G, B order; only read */
+		RLS_Convert_888to565((RGB888_T*)pRaw, pDest, nWidth, nHeight);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_Rawto565
+**
+** Description:
+**     Convert a raw RGB565 or RGB24 file holding one frame to RGB565
+**
+** Input:
+**     pszFn - File name
+**     nPixBytes - 2 for RGB565, 3 for RGB24
+**     nWidth - Width
+**     nHeight - Height
+**
+** Output:
+**     none
+**
+** Return value:
+**     Converted image (free with free()), NULL on failure or when the
+**     file size does not match the frame size
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RGB565_T* RLS_Import_Rawto565(const char* pszFn, int nPixBytes, int nWidth,
+							  int nHeight)
+{
+	RLSFileMap_T tMap;
+	RGB565_T* pImg = NULL;
+	if (nWidth <= 0 || nHeight <= 0
+	 || (nPixBytes != sizeof(RGB565_T) && nPixBytes != sizeof(RGB888_T))
+	 || !RLS_FileMap_Open(&tMap, pszFn))
+		return NULL;
+	if (tMap.nSize == (uint64_t)nWidth * nHeight * nPixBytes)
+	{
+		pImg = (RGB565_T*)malloc((size_t)nWidth * nHeight
+								 * sizeof(RGB565_T));
+		if (pImg)
+			RLS_Import_RawFrame(tMap.pData, nPixBytes, pImg, nWidth,
+								nHeight);
+	}
+	RLS_FileMap_Close(&tMap);
+	return pImg;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_BMPto565
+**
+** Description:
+**     Convert an uncompressed BMP file to RGB565. 16 bpp RGB565 rows are
+**     copied as they are.
+**
+** Input:
+**     pszFn - File name
+**     pnWidth - Width pointer
+**     pnHeight - Height pointer
+**
+** Output:
+**     Width, height
+**
+** Return value:
+**     Converted image (free with free()), NULL on failure
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RGB565_T* RLS_Import_BMPto565(const char* pszFn, int* pnWidth,
+							  int* pnHeight)
+{
+	RLSFileMap_T tMap;
+	RLSBMPInfo_T* ptInfo;
+	RGB565_T* pImg = NULL;
+	int nY;
+
+	if (!pnWidth || !pnHeight || !RLS_FileMap_Open(&tMap, pszFn))
+		return NULL;
+	ptInfo = (RLSBMPInfo_T*)malloc(sizeof(RLSBMPInfo_T));
+	if (ptInfo && RLS_Import_BMPInfo(&tMap, ptInfo))
+		pImg = (RGB565_T*)malloc((size_t)ptInfo->nWidth * ptInfo->nHeight
+								 * sizeof(RGB565_T));
+	if (pImg)
+	{
+		for (nY = 0; nY < ptInfo->nHeight; nY++)
+		{
+			int nSrcY = ptInfo->bTopDown ? nY : ptInfo->nHeight - 1 - nY;
+			RLS_Import_BMPRow(ptInfo, tMap.pData + ptInfo->nOffset
+							  + ptInfo->nStride * nSrcY,
+							  pImg + (size_t)ptInfo->nWidth * nY);
+		}
+		*pnWidth = ptInfo->nWidth;
+		*pnHeight = ptInfo->nHeight;
+	}
+	free(ptInfo);
+	RLS_FileMap_Close(&tMap);
+	return pImg;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Import_PNMto565
+**
+** Description:
+**     Convert a binary PGM (P5), PPM (P6) or PAM (P7) file to RGB565.
+**     Only the first image of a multi-image file is read. Gray images are
+**     expanded, alpha is ignored.
+**
+** Input:
+**     pszFn - File name
+**     pnWidth - Width pointer
+**     pnHeight - Height pointer
+**
+** Output:
+**     Width, height
+**
+** Return value:
+**     Converted image (free with free()), NULL on failure
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RGB565_T* RLS_Import_PNMto565(const char* pszFn, int* pnWidth,
+							  int* pnHeight)
+{
+	RLSFileMap_T tMap;
+	RGB565_T* pImg = NULL;
+	const char* pszToken;
+	const uint8_t* pPix;
+	size_t nPos = 2, nLen, nPixels, nPix;
+	int nWidth = 0, nHeight = 0, nDepth = 0, nMaxVal = 0, nSample;
+	bool bOK = true;
+
+	if (!pnWidth || !pnHeight || !RLS_FileMap_Open(&tMap, pszFn))
+		return NULL;
+	if (tMap.nSize < 3 || tMap.pData[0] != 'P')
+		bOK = false;
+	else if (tMap.pData[1] == '5' || tMap.pData[1] == '6')
+	{
+		nDepth = (tMap.pData[1] == '5') ? 1 : 3;
+		bOK = RLS_Import_PNMNumber(&tMap, &nPos, &nWidth)
+		   && RLS_Import_PNMNumber(&tMap, &nPos, &nHeight)
+		   && RLS_Import_PNMNumber(&tMap, &nPos, &nMaxVal);
+	}
+	else if (tMap.pData[1] == '7')
+	{
+		while ((bOK = RLS_Import_PNMToken(&tMap, &nPos, &pszToken, &nLen)))
+		{
+			if (nLen == 6 && memcmp(pszToken, "ENDHDR", 6) == 0)
+				break;
+			if (nLen == 5 && memcmp(pszToken, "WIDTH", 5) == 0)
+				bOK = RLS_Import_PNMNumber(&tMap, &nPos, &nWidth);
+			else if (nLen == 6 && memcmp(pszToken, "HEIGHT", 6) == 0)
+				bOK = RLS_Import_PNMNumber(&tMap, &nPos, &nHeight);
+			else if (nLen == 5 && memcmp(pszToken, "DEPTH", 5) == 0)
+				bOK = RLS_Import_PNMNumber(&tMap, &nPos, &nDepth);
+			else if (nLen == 6 && memcmp(pszToken, "MAXVAL", 6) == 0)
+				bOK = RLS_Import_PNMNumber(&tMap, &nPos, &nMaxVal);
+			else if (nLen == 8 && memcmp(pszToken, "TUPLTYPE", 8) == 0)
+				/* implied by DEPTH */
+				bOK = RLS_Import_PNMToken(&tMap, &nPos, &pszToken, &nLen);
+			else
+				bOK = false;
+			if (!bOK)
+				break;
+		}
+	}
+	else
+		bOK = false;
+
+	/* a single whitespace byte separates the header from the pixels */
+	nSample = (nMaxVal > UINT8_MAX) ? 2 : 1;
+	nPixels = (size_t)nWidth * nHeight;
+	if (bOK && nWidth > 0 && nHeight > 0 && nDepth >= 1 && nDepth <= 4
+	 && nMaxVal >= 1 && nMaxVal <= UINT16_MAX && nPos < tMap.nSize
+	 && (uint64_t)nWidth * nHeight * nDepth * nSample
+	  <= tMap.nSize - nPos - 1)
+		pImg = (RGB565_T*)malloc(nPixels * sizeof(RGB565_T));
+	if (pImg)
+	{
+		pPix = tMap.pData + nPos + 1;
+		if (nDepth == 3 && nMaxVal == UINT8_MAX)
+			RLS_Import_RawFrame(pPix, sizeof(RGB888_T), pImg, nWidth,
+								nHeight);
+		else
+		{
+			for (nPix = 0; nPix < nPixels; nPix++)
+			{
+				uint32_t anVal[3];
+				int nChan;
+				/* gray (+ alpha) repeats channel 0 */
+				for (nChan = 0; nChan < 3; nChan++)
+				{
+					const uint8_t* pSample = pPix + ((nDepth < 3) ?
+											 0 : nChan * nSample);
+					uint32_t nVal = (nSample == 2) ?
+									((pSample[0] << 8) | pSample[1]) :
+									pSample[0];
+					if (nVal > (uint32_t)nMaxVal)
+						nVal = nMaxVal;
+					anVal[nChan] = (nVal * 255 + nMaxVal / 2) / nMaxVal;
+				}
+				pImg[nPix] = RLS_IMPORT_PACK(anVal[0], anVal[1], anVal[2]);
+				pPix += nDepth * nSample;
+			}
+		}
+		*pnWidth = nWidth;
+		*pnHeight = nHeight;
+	}
+	RLS_FileMap_Close(&tMap);
+	return pImg;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+** ===========================================================================
+** File: import.h
+** Description: ReakoLite library uncompressed image import header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_IMPORT_H
+#define RLS_IMPORT_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "convert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern void RLS_Import_RawFrame(const uint8_t* pRaw, int nPixBytes,
+								RGB565_T* pDest, int nWidth, int nHeight);
+extern RGB565_T* RLS_Import_Rawto565(const char* pszFn, int nPixBytes,
+									 int nWidth, int nHeight);
+extern RGB565_T* RLS_Import_BMPto565(const char* pszFn, int* pnWidth,
+									 int* pnHeight);
+extern RGB565_T* RLS_Import_PNMto565(const char* pszFn, int* pnWidth,
+									 int* pnHeight);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_IMPORT_H
\ No newline at end of file
@@ -6,6 +6,30 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Refuse edits under frames drawn over others
+** 10/18/2026	agent			Decoded frame cache playback option
+** 10/18/2026	agent			Warn about frames the palette fallback changes
+** 10/18/2026	agent			Lossless optimize mode
+** 10/18/2026	agent			Container editing mode
+** 10/18/2026	agent			Encoded frame cache option
+** 10/18/2026	agent			Changed rectangle listing
+** 10/18/2026	agent			Prefetching playback benchmark mode
+** 10/18/2026	agent			Resource pack mode
+** 10/18/2026	agent			Byte budget encode option
+** 10/18/2026	agent			Firmware blob scan mode
+** 10/18/2026	agent			Frame index
+** 10/18/2026	agent			Encode sprite sheet cells in place
+** 10/18/2026	agent			Sprite sheet slicing
+** 10/18/2026	agent			BMP, PNM and raw image import
+** 10/18/2026	agent			Raw frame stream input
+** 10/18/2026	agent			Raw frame stream output
+** 10/18/2026	agent			Pipelined PNG export
+** 10/18/2026	agent			PNG export thread option
+** 10/18/2026	agent			Indexed PNG export option
+** 10/18/2026	agent			PNG export profile and filter options
+** 10/18/2026	agent			Standard palette snapping option
+** 10/18/2026	agent			Block merge quantizer option
+** 10/18/2026	agent			Quantizer selection
 ** 08/26/2024	raulmrio28-git	Add encode support (PNG only!)
 ** 08/25/2024	raulmrio28-git	Initial version
 ** ===========================================================================
@@ -21,10 +45,30 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <direct.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "budget.h"
+#include "cache.h"
 #include "common.h"
 #include "convert.h"
 #include "decode.h"
+#include "ecache.h"
+#include "edit.h"
 #include "encode.h"
+#include "export.h"
+#include "filemap.h"
+#include "import.h"
+#include "optimize.h"
+#include "pack.h"
+#include "player.h"
+#include "quant.h"
+#include "scan.h"
+#include "thread.h"
 
 /*
 **----------------------------------------------------------------------------
@@ -32,16 +76,20 @@
 **----------------------------------------------------------------------------
 */
 
-#define RLS_ENCODE_BSIZE(nWidth, nHeight) \
-	(2*sizeof(uint32_t)+(RLS_EPAL_SIZE*(RLS_PAL_BYTES+RLS_SPAL_SIZE)) \
-	+((nWidth*nHeight*5)/4))
-
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
 **----------------------------------------------------------------------------
 */
 
+typedef enum tagRLS_QM_E
+{
+	RLS_QM_NONE = 0,
+	RLS_QM_RPZA = 1,
+	RLS_QM_PAL = 2,
+	RLS_QM_BOTH = 3
+} RLS_QM_E;
+
 /*
 **----------------------------------------------------------------------------
 **  Global variables
@@ -54,14 +102,19 @@
 **----------------------------------------------------------------------------
 */
 
+/* -r names and stream file extensions, same order as RLS_EXPF_E */
+static const char* RLS_Main_StreamFmts[] =
+	{"rgb565", "rgb24", "rgba", "ppm", "pam"};
+
+/* -k encoded frame cache, closed (no path) unless asked for */
+static RLSECache_T RLS_Main_ECache;
+
 /*
 **----------------------------------------------------------------------------
 **  Function(internal use only) Declarations
 **----------------------------------------------------------------------------
 */
 
-extern void RLS_Quantize(RGB565_T* pImg, int nWidth, int nHeight);
-
 const char* FileExt(const char* pszFn)
 {
 	const char* pszFnSrch = pszFn + strlen(pszFn) - 1;
@@ -74,22 +127,1253 @@ const char* FileExt(const char* pszFn)
 	return NULL;
 }
 
+bool RLS_Main_PNGProfile(const char* pszName)
+{
+	if (_stricmp(pszName, "store") == 0)
+		RLS_Convert_SetPNGProfile(RLS_PNGP_STORE);
+	else if (_stricmp(pszName, "fast") == 0)
+		RLS_Convert_SetPNGProfile(RLS_PNGP_FAST);
+	else if (_stricmp(pszName, "max") == 0)
+		RLS_Convert_SetPNGProfile(RLS_PNGP_MAX);
+	else
+	{
+		printf("Unknown PNG profile %s\n", pszName);
+		return false;
+	}
+	return true;
+}
+
+int RLS_Main_PNGFilters(const char* pszList)
+{
+	static const struct { const char* pszName; int nFilter; } atFilters[] =
+	{
+		{ "none", RLS_PNGF_NONE }, { "sub", RLS_PNGF_SUB },
+		{ "up", RLS_PNGF_UP }, { "avg", RLS_PNGF_AVG },
+		{ "paeth", RLS_PNGF_PAETH }, { "all", RLS_PNGF_ALL }
+	};
+	int nCount = (int)(sizeof(atFilters) / sizeof(atFilters[0]));
+	int nFilters = 0;
+	while (*pszList)
+	{
+		size_t nLen = strcspn(pszList, ",");
+		int nIdx;
+		for (nIdx = 0; nIdx < nCount; nIdx++)
+			if (strlen(atFilters[nIdx].pszName) == nLen
+			 && strncmp(atFilters[nIdx].pszName, pszList, nLen) == 0)
+				break;
+		if (nIdx == nCount)
+			return 0;
+		nFilters |= atFilters[nIdx].nFilter;
+		pszList += nLen;
+		if (*pszList == ',')
+			pszList++;
+	}
+	return nFilters;
+}
+
+int RLS_Main_EncodeFrame(uint16_t* pDec, uint8_t* pOut, int nWidth,
+						 int nHeight, int nStride, RLS_QM_E eQuant,
+						 int nMergeTol, int* pnMergeSaved, int nFrame)
+{
+	uint16_t awPal[RLS_SPAL_SIZE];
+	int nPalCols = 0;
+	int nMergeBefore = *pnMergeSaved;
+	uint32_t anParms[3];
+	uint64_t nKey = 0;
+	int32_t nExtra;
+	uint32_t nSize;
+	if (RLS_Main_ECache.pszPath)
+	{
+		/* everything that changes the encoded bytes, before quantizing
+		   touches the pixels */
+		anParms[0] = eQuant;
+		anParms[1] = nMergeTol;
+		anParms[2] = RLS_Encode_GetSnap();
+		nKey = RLS_ECache_Key(pDec, nWidth, nHeight, nStride, anParms, 3);
+		nSize = RLS_ECache_Load(&RLS_Main_ECache, nKey, pOut,
+								RLS_ENCODE_BSIZE(nWidth, nHeight), &nExtra);
+		if (nSize)
+		{
+			*pnMergeSaved += nExtra;
+			return nSize;
+		}
+	}
+	if (eQuant & RLS_QM_RPZA)
+		RLS_Quantize(pDec, nWidth, nHeight, nStride);
+	if (eQuant & RLS_QM_PAL)
+	{
+		nPalCols = RLS_Quantize_Palette(pDec, nWidth, nHeight, nStride,
+										awPal, RLS_SPAL_SIZE);
+		RLS_Encode_SetSPal(awPal, nPalCols);
+	}
+	if (nMergeTol > 0)
+		*pnMergeSaved += RLS_Quantize_Blocks(pDec, nWidth, nHeight, nStride,
+							nMergeTol, nPalCols ? awPal : NULL, nPalCols);
+	nSize = RLS_Encode(pDec, pOut, false, 0, nWidth, nHeight, nStride);
+	if (!nSize)
+	{
+		printf("Failed to encode frame %d\n", nFrame);
+		return 0;
+	}
+	/* not cached, so every encode of the frame warns */
+	if (RLS_Encode_GetLossy())
+		printf("Frame %d: extended palette full, %lu pixels changed to the "
+			   "nearest standard palette color\n", nFrame,
+			   (unsigned long)RLS_Encode_GetLossy());
+	else if (RLS_Main_ECache.pszPath)
+		RLS_ECache_Store(&RLS_Main_ECache, nKey, pOut, nSize,
+						 *pnMergeSaved - nMergeBefore);
+	return nSize;
+}
+
+void RLS_Main_ECacheDone(void)
+{
+	if (!RLS_Main_ECache.pszPath)
+		return;
+	printf("Encode cache: %lu hits, %lu misses, %lu stored\n",
+		   (unsigned long)RLS_Main_ECache.nHits,
+		   (unsigned long)RLS_Main_ECache.nMisses,
+		   (unsigned long)RLS_Main_ECache.nStored);
+	RLS_ECache_Close(&RLS_Main_ECache);
+}
+
+uint16_t* RLS_Main_Import(const char* pszFn, int nRawWidth, int nRawHeight,
+						  int* pnWidth, int* pnHeight)
+{
+	const char* pszExt = FileExt(pszFn);
+	uint16_t* pDec;
+	if (!pszExt)
+		pszExt = "";
+	if (_stricmp(pszExt, "png") == 0)
+		pDec = RLS_Convert_PNGto565(pszFn, pnWidth, pnHeight);
+	else if (_stricmp(pszExt, "bmp") == 0 || _stricmp(pszExt, "dib") == 0)
+		pDec = RLS_Import_BMPto565(pszFn, pnWidth, pnHeight);
+	else if (_stricmp(pszExt, "ppm") == 0 || _stricmp(pszExt, "pgm") == 0
+		  || _stricmp(pszExt, "pnm") == 0 || _stricmp(pszExt, "pam") == 0)
+		pDec = RLS_Import_PNMto565(pszFn, pnWidth, pnHeight);
+	else if (_stricmp(pszExt, "rgb565") == 0 || _stricmp(pszExt, "rgb24") == 0)
+	{
+		if (nRawWidth <= 0 || nRawHeight <= 0)
+		{
+			printf("Raw image %s needs a frame size (-g)\n", pszFn);
+			return NULL;
+		}
+		pDec = RLS_Import_Rawto565(pszFn,
+								   (_stricmp(pszExt, "rgb24") == 0) ? 3 : 2,
+								   nRawWidth, nRawHeight);
+		*pnWidth = nRawWidth;
+		*pnHeight = nRawHeight;
+	}
+	else
+	{
+		printf("File %s is not a supported image\n", pszFn);
+		return NULL;
+	}
+	if (!pDec)
+		printf("Failed to convert file %s\n", pszFn);
+	return pDec;
+}
+
+int RLS_Main_EncodeFrames(FILE* pIn, FILE* pOut, RLS_EXPF_E eFormat,
+						  int nWidth, int nHeight, RLS_QM_E eQuant,
+						  int nMergeTol, uint32_t* pnOffsets,
+						  int* pnSavingCalcSize, int* pnMergeSaved)
+{
+	size_t nPixels = (size_t)nWidth * nHeight;
+	size_t nFrameSize = nPixels * (eFormat == RLS_EXPF_RGB565 ? 2 : 3);
+	uint8_t* pRaw = (uint8_t*)malloc(nFrameSize);
+	uint16_t* pDec = (uint16_t*)malloc(nPixels * sizeof(uint16_t));
+	uint8_t* pEnc = (uint8_t*)malloc(RLS_ENCODE_BSIZE(nWidth, nHeight));
+	size_t nRead;
+	uint32_t nOffset = 12; /* frames follow the header */
+	int nFrames = 0;
+	bool bOK = pRaw && pDec && pEnc;
+
+	if (!bOK)
+		printf("Failed to allocate memory\n");
+	while (bOK && (nRead = fread(pRaw, 1, nFrameSize, pIn)) != 0)
+	{
+		int nSize;
+		if (nRead != nFrameSize)
+		{
+			printf("Frame %d is truncated\n", nFrames);
+			bOK = false;
+			break;
+		}
+		if (nFrames == UINT8_MAX)
+		{
+			printf("More than %d frames\n", UINT8_MAX);
+			bOK = false;
+			break;
+		}
+		RLS_Import_RawFrame(pRaw, (eFormat == RLS_EXPF_RGB565) ? 2 : 3, pDec,
+							nWidth, nHeight);
+		nSize = RLS_Main_EncodeFrame(pDec, pEnc, nWidth, nHeight, nWidth,
+									 eQuant, nMergeTol, pnMergeSaved,
+									 nFrames);
+		if (!nSize)
+		{
+			bOK = false; /* already reported */
+			break;
+		}
+		if (fwrite(pEnc, 1, nSize, pOut) != (size_t)nSize)
+		{
+			printf("Failed to write frame %d\n", nFrames);
+			bOK = false;
+			break;
+		}
+		*pnSavingCalcSize += nSize - (2 * sizeof(uint32_t));
+		pnOffsets[nFrames++] = nOffset;
+		nOffset += nSize;
+	}
+	if (bOK && ferror(pIn))
+	{
+		printf("Failed to read frame %d\n", nFrames);
+		bOK = false;
+	}
+	else if (bOK && !nFrames)
+		printf("No frames in input\n");
+	free(pEnc);
+	free(pDec);
+	free(pRaw);
+	return bOK ? nFrames : 0;
+}
+
+FILE* RLS_Main_BeginRLS(const char* pszOut)
+{
+	uint8_t abHeader[12] = {0};
+	FILE* pOut = fopen(pszOut, "wb");
+	if (!pOut)
+	{
+		printf("Failed to open file %s\n", pszOut);
+		return NULL;
+	}
+	/* frames are written as they are encoded, the header needs the frame
+	   count and is filled in by RLS_Main_EndRLS */
+	if (fwrite(abHeader, 1, sizeof(abHeader), pOut) != sizeof(abHeader))
+	{
+		printf("Failed to write file %s\n", pszOut);
+		fclose(pOut);
+		remove(pszOut);
+		return NULL;
+	}
+	return pOut;
+}
+
+int RLS_Main_EndRLS(FILE* pOut, const char* pszOut, int nFrames,
+					const uint32_t* pnOffsets, int nWidth, int nHeight,
+					int nSavingCalcSize)
+{
+	uint8_t abHeader[12] = {0};
+	uint8_t abIndex[RLS_INDEX_SIZE(UINT8_MAX)];
+	bool bOK = true;
+	if (nFrames && pnOffsets)
+	{
+		/* the frames end where the index goes */
+		int nIndexSize = RLS_Common_MakeIndex(abIndex, pnOffsets, nFrames);
+		bOK = fwrite(abIndex, 1, nIndexSize, pOut) == (size_t)nIndexSize;
+	}
+	if (nFrames && bOK)
+	{
+		RLS_Common_MakeInfo(abHeader, nFrames, nWidth, nHeight,
+			RLS_CALC_SAVING((nWidth*nHeight*nFrames), nSavingCalcSize),
+			false);
+		bOK = fseek(pOut, 0, SEEK_SET) == 0
+		   && fwrite(abHeader, 1, sizeof(abHeader), pOut) == sizeof(abHeader);
+	}
+	if (fclose(pOut) != 0)
+		bOK = false;
+	if (!nFrames || !bOK)
+	{
+		/* a failed encode has already said why */
+		if (nFrames)
+			printf("Failed to write file %s\n", pszOut);
+		remove(pszOut);
+		return 1;
+	}
+	printf("Encoded %d frames\n", nFrames);
+	return 0;
+}
+
+int RLS_Main_EncodeStream(const char* pszOut, const char* pszIn,
+						  RLS_EXPF_E eFormat, int nWidth, int nHeight,
+						  RLS_QM_E eQuant, int nMergeTol, bool bIndex)
+{
+	FILE* pIn;
+	FILE* pOut;
+	uint32_t anOffsets[UINT8_MAX];
+	int nFrames;
+	int nSavingCalcSize = 0;
+	int nMergeSaved = 0;
+	int nResult;
+
+	if (!pszIn || strcmp(pszIn, "-") == 0)
+	{
+#ifdef _WIN32
+		_setmode(_fileno(stdin), _O_BINARY);
+#endif
+		pIn = stdin;
+	}
+	else if (!(pIn = fopen(pszIn, "rb")))
+	{
+		printf("Failed to open file %s\n", pszIn);
+		return 1;
+	}
+	pOut = RLS_Main_BeginRLS(pszOut);
+	if (!pOut)
+	{
+		if (pIn != stdin)
+			fclose(pIn);
+		return 1;
+	}
+	nFrames = RLS_Main_EncodeFrames(pIn, pOut, eFormat, nWidth, nHeight,
+									eQuant, nMergeTol, anOffsets,
+									&nSavingCalcSize, &nMergeSaved);
+	if (pIn != stdin)
+		fclose(pIn);
+	nResult = RLS_Main_EndRLS(pOut, pszOut, nFrames,
+							  bIndex ? anOffsets : NULL, nWidth, nHeight,
+							  nSavingCalcSize);
+	if (!nResult && nMergeTol > 0)
+		printf("Block merge saved %s%d bytes\n",
+			   (eQuant & RLS_QM_PAL) ? "" : "at least ", nMergeSaved);
+	return nResult;
+}
+
+int RLS_Main_EncodeAtlas(const char* pszOut, const char* pszIn,
+						 int nRawWidth, int nRawHeight, int nWidth,
+						 int nHeight, int nCount, int nPad, RLS_QM_E eQuant,
+						 int nMergeTol, bool bIndex)
+{
+	FILE* pOut;
+	uint16_t* pAtlas;
+	uint8_t* pEnc;
+	uint32_t anOffsets[UINT8_MAX];
+	uint32_t nOffset = 12; /* frames follow the header */
+	int nAtlasWidth, nAtlasHeight;
+	int nCols, nRows, nFrame;
+	int nSavingCalcSize = 0;
+	int nMergeSaved = 0;
+	int nResult;
+
+	/* decoded once, every frame is a cell of the grid */
+	pAtlas = RLS_Main_Import(pszIn, nRawWidth, nRawHeight, &nAtlasWidth,
+							 &nAtlasHeight);
+	if (!pAtlas)
+		return 1;
+	nCols = (nAtlasWidth + nPad) / (nWidth + nPad);
+	nRows = (nAtlasHeight + nPad) / (nHeight + nPad);
+	if (nCount <= 0)
+		nCount = nCols * nRows;
+	if (nCount <= 0 || nCount > nCols * nRows)
+	{
+		printf("%s holds %d frames of %dx%d\n", pszIn, nCols * nRows,
+			   nWidth, nHeight);
+		free(pAtlas);
+		return 1;
+	}
+	if (nCount > UINT8_MAX)
+	{
+		printf("More than %d frames\n", UINT8_MAX);
+		free(pAtlas);
+		return 1;
+	}
+	pEnc = (uint8_t*)malloc(RLS_ENCODE_BSIZE(nWidth, nHeight));
+	pOut = pEnc ? RLS_Main_BeginRLS(pszOut) : NULL;
+	if (!pOut)
+	{
+		if (!pEnc)
+			printf("Failed to allocate memory\n");
+		free(pEnc);
+		free(pAtlas);
+		return 1;
+	}
+	for (nFrame = 0; nFrame < nCount; nFrame++)
+	{
+		int nX0 = (nFrame % nCols) * (nWidth + nPad);
+		int nY0 = (nFrame / nCols) * (nHeight + nPad);
+		int nSize;
+		/* cells do not overlap, so quantizing one in place inside the
+		   sheet leaves the others alone */
+		nSize = RLS_Main_EncodeFrame(pAtlas + (size_t)nAtlasWidth * nY0
+									 + nX0, pEnc, nWidth, nHeight,
+									 nAtlasWidth, eQuant, nMergeTol,
+									 &nMergeSaved, nFrame);
+		if (!nSize)
+			break; /* already reported, the output is removed */
+		if (fwrite(pEnc, 1, nSize, pOut) != (size_t)nSize)
+		{
+			printf("Failed to write frame %d\n", nFrame);
+			break;
+		}
+		nSavingCalcSize += nSize - (2 * sizeof(uint32_t));
+		anOffsets[nFrame] = nOffset;
+		nOffset += nSize;
+	}
+	free(pEnc);
+	free(pAtlas);
+	nResult = RLS_Main_EndRLS(pOut, pszOut, (nFrame == nCount) ? nCount : 0,
+							  bIndex ? anOffsets : NULL, nWidth, nHeight,
+							  nSavingCalcSize);
+	if (!nResult && nMergeTol > 0)
+		printf("Block merge saved %s%d bytes\n",
+			   (eQuant & RLS_QM_PAL) ? "" : "at least ", nMergeSaved);
+	return nResult;
+}
+
+int RLS_Main_EncodeBudget(const char* pszOut, char** apszIn, int nFrames,
+						  int nRawWidth, int nRawHeight, RLS_QM_E eQuant,
+						  bool bIndex, size_t nMaxSize, int nThreads)
+{
+	RLSBudget_T tBudget;
+	RLSBudgetParm_T tParm;
+	RGB565_T* apFrames[UINT8_MAX] = {NULL};
+	uint32_t anOffsets[UINT8_MAX];
+	RGB565_T* pWork = NULL;
+	uint8_t* pEnc = NULL;
+	FILE* pOut = NULL;
+	size_t nSize;
+	uint64_t nError = 0;
+	uint32_t nOffset = 12; /* frames follow the header */
+	int nWidth = 0, nHeight = 0;
+	int nFrame;
+	int nSavingCalcSize = 0;
+	int nResult = 1;
+	bool bOK = true;
+
+	/* every candidate encodes all frames, so they are loaded up front */
+	for (nFrame = 0; bOK && nFrame < nFrames; nFrame++)
+	{
+		int nVW, nVH;
+		apFrames[nFrame] = RLS_Main_Import(apszIn[nFrame], nRawWidth,
+										   nRawHeight, &nVW, &nVH);
+		if (!apFrames[nFrame])
+			bOK = false;
+		else if (!nFrame)
+		{
+			nWidth = nVW;
+			nHeight = nVH;
+		}
+		else if (nVW != nWidth || nVH != nHeight)
+		{
+			printf("%s has different dimensions\n", apszIn[nFrame]);
+			bOK = false;
+		}
+	}
+	if (bOK)
+	{
+		tBudget.apFrames = apFrames;
+		tBudget.nFrames = nFrames;
+		tBudget.nWidth = nWidth;
+		tBudget.nHeight = nHeight;
+		tBudget.bRPZA = (eQuant & RLS_QM_RPZA) != 0;
+		tBudget.bPal = (eQuant & RLS_QM_PAL) != 0;
+		tBudget.nOverhead = 12 + (bIndex ? RLS_INDEX_SIZE(nFrames) : 0);
+		tBudget.nMaxSize = nMaxSize;
+		if (nThreads <= 0)
+			nThreads = RLS_Thread_GetCPUs();
+		if (!RLS_Budget_Search(&tBudget, nThreads, &tParm, &nSize, &nError))
+		{
+			if (nSize)
+				printf("Nothing fits in %llu bytes, the smallest is %llu "
+					   "bytes\n", (unsigned long long)nMaxSize,
+					   (unsigned long long)nSize);
+			else
+				printf("Failed to encode\n");
+			bOK = false;
+		}
+	}
+	if (bOK)
+	{
+		printf("Quantizer %d/%d, merge %d, snap %d: %llu bytes, mean color "
+			   "difference %.2f\n", tParm.nFlatTol, tParm.nFitTol,
+			   tParm.nMergeTol, tParm.nSnapTol, (unsigned long long)nSize,
+			   (double)nError / ((double)nWidth * nHeight * nFrames));
+		pWork = (RGB565_T*)malloc((size_t)nWidth * nHeight
+								  * sizeof(RGB565_T));
+		pEnc = (uint8_t*)malloc(RLS_ENCODE_BSIZE(nWidth, nHeight));
+		if (!pWork || !pEnc)
+		{
+			printf("Failed to allocate memory\n");
+			bOK = false;
+		}
+	}
+	if (bOK)
+		pOut = RLS_Main_BeginRLS(pszOut);
+	if (pOut)
+	{
+		/* the search does not keep its encodes, the winner is redone */
+		for (nFrame = 0; bOK && nFrame < nFrames; nFrame++)
+		{
+			uint32_t nFrameSize = RLS_Budget_EncodeFrame(apFrames[nFrame],
+										NULL, pWork, pEnc, nWidth, nHeight,
+										tBudget.bRPZA, tBudget.bPal, &tParm);
+			if (!nFrameSize
+			 || fwrite(pEnc, 1, nFrameSize, pOut) != nFrameSize)
+			{
+				printf("Failed to write frame %d\n", nFrame);
+				bOK = false;
+				break;
+			}
+			nSavingCalcSize += nFrameSize - (2 * sizeof(uint32_t));
+			anOffsets[nFrame] = nOffset;
+			nOffset += nFrameSize;
+		}
+		nResult = RLS_Main_EndRLS(pOut, pszOut, bOK ? nFrames : 0,
+								  bIndex ? anOffsets : NULL, nWidth, nHeight,
+								  nSavingCalcSize);
+	}
+	free(pEnc);
+	free(pWork);
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
+		free(apFrames[nFrame]);
+	return nResult;
+}
+
+bool RLS_Main_MakeDir(const char* pszDir)
+{
+	struct stat tStat;
+#ifdef _WIN32
+	if (_mkdir(pszDir) == 0)
+#else
+	if (mkdir(pszDir, 0777) == 0)
+#endif
+		return true;
+	/* already there is fine */
+	return stat(pszDir, &tStat) == 0 && (tStat.st_mode & S_IFDIR);
+}
+
+int RLS_Main_Scan(const char* pszIn, const char* pszDir, int nThreads)
+{
+	RLSFileMap_T tMap;
+	RLSScanHit_T* ptHits;
+	int nHits, nHit, nWorkers, nExtracted;
+
+	if (!RLS_FileMap_Open(&tMap, pszIn))
+	{
+		printf("Failed to open file %s\n", pszIn);
+		return 1;
+	}
+	nHits = RLS_Scan_Find(tMap.pData, tMap.nSize, &ptHits);
+	if (nHits < 0)
+	{
+		printf("Failed to allocate memory\n");
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	printf("Found %d images in %s\n", nHits, pszIn);
+	if (!nHits)
+	{
+		RLS_FileMap_Close(&tMap);
+		return 0;
+	}
+	if (!RLS_Main_MakeDir(pszDir))
+	{
+		printf("Failed to create directory %s\n", pszDir);
+		free(ptHits);
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	/* images are written concurrently, the threads left over go to the
+	   strips of each frame */
+	if (nThreads <= 0)
+		nThreads = RLS_Thread_GetCPUs();
+	nWorkers = (nThreads < nHits) ? nThreads : nHits;
+	RLS_Convert_SetPNGThreads((nThreads / nWorkers > 1) ?
+							  nThreads / nWorkers : 1);
+	nExtracted = RLS_Scan_Extract(tMap.pData, ptHits, nHits, pszDir,
+								  nWorkers);
+	for (nHit = 0; nHit < nHits; nHit++)
+	{
+		RLSScanHit_T* ptHit = &ptHits[nHit];
+		printf("%08llX: %dx%d, %d frames, %llu bytes",
+			   (unsigned long long)ptHit->nOffset, ptHit->nWidth,
+			   ptHit->nHeight, ptHit->nFrames,
+			   (unsigned long long)ptHit->nSize);
+		switch (ptHit->nResult)
+		{
+		case RLS_EXPORT_OK:
+			printf("\n");
+			break;
+		case RLS_EXPORT_EDECODE:
+			printf(", failed to decode frame %d\n", ptHit->nFailed);
+			break;
+		case RLS_EXPORT_ECONVERT:
+			printf(", failed to convert frame %d\n", ptHit->nFailed);
+			break;
+		case RLS_EXPORT_EWRITE:
+			printf(", failed to write file\n");
+			break;
+		default:
+			printf(", failed to allocate memory\n");
+			break;
+		}
+	}
+	printf("Extracted %d of %d images to %s\n", nExtracted, nHits, pszDir);
+	free(ptHits);
+	RLS_FileMap_Close(&tMap);
+	return (nExtracted == nHits) ? 0 : 1;
+}
+
+char* RLS_Main_AssetName(const char* pszFn)
+{
+	const char* pszBase = pszFn;
+	const char* pszExt;
+	const char* pszPos;
+	char* pszName;
+	/* directories and the extension are not part of the name */
+	for (pszPos = pszFn; *pszPos; pszPos++)
+		if (*pszPos == '/' || *pszPos == '\\')
+			pszBase = pszPos + 1;
+	pszExt = strrchr(pszBase, '.');
+	if (!pszExt || pszExt == pszBase)
+		pszExt = pszBase + strlen(pszBase);
+	pszName = (char*)malloc(pszExt - pszBase + 1);
+	if (pszName)
+	{
+		memcpy(pszName, pszBase, pszExt - pszBase);
+		pszName[pszExt - pszBase] = '\0';
+	}
+	return pszName;
+}
+
+int RLS_Main_Pack(const char* pszOut, char** apszIn, int nInputs)
+{
+	RLSFileMap_T* ptMaps;
+	RLSPackItem_T* ptItems;
+	FILE* pOut = NULL;
+	int nInput, nFailed = -1;
+	int nResult = RLS_PACK_EMEM;
+
+	ptMaps = (RLSFileMap_T*)calloc(nInputs, sizeof(RLSFileMap_T));
+	ptItems = (RLSPackItem_T*)calloc(nInputs, sizeof(RLSPackItem_T));
+	for (nInput = 0; ptMaps && ptItems && nInput < nInputs; nInput++)
+	{
+		if (!RLS_FileMap_Open(&ptMaps[nInput], apszIn[nInput]))
+		{
+			printf("Failed to open file %s\n", apszIn[nInput]);
+			break;
+		}
+		ptItems[nInput].pszName = RLS_Main_AssetName(apszIn[nInput]);
+		ptItems[nInput].pData = ptMaps[nInput].pData;
+		ptItems[nInput].nSize = ptMaps[nInput].nSize;
+		if (!ptItems[nInput].pszName)
+		{
+			printf("Failed to allocate memory\n");
+			break;
+		}
+	}
+	if (ptMaps && ptItems && nInput == nInputs)
+	{
+		pOut = fopen(pszOut, "wb");
+		if (!pOut)
+			printf("Failed to open file %s\n", pszOut);
+	}
+	else if (!ptMaps || !ptItems)
+		printf("Failed to allocate memory\n");
+	if (pOut)
+	{
+		nResult = RLS_Pack_Write(pOut, ptItems, nInputs, &nFailed);
+		if (fclose(pOut) != 0 && nResult == RLS_PACK_OK)
+			nResult = RLS_PACK_EWRITE;
+		switch (nResult)
+		{
+		case RLS_PACK_OK:
+			printf("Packed %d images\n", nInputs);
+			break;
+		case RLS_PACK_EIMAGE:
+			printf("%s is not an RLS image\n", ptItems[nFailed].pszName);
+			break;
+		case RLS_PACK_ENAME:
+			printf("Name %s is empty, too long or used twice\n",
+				   ptItems[nFailed].pszName);
+			break;
+		case RLS_PACK_ELARGE:
+			printf("Pack would exceed 4 GB\n");
+			break;
+		case RLS_PACK_EWRITE:
+			printf("Failed to write file %s\n", pszOut);
+			break;
+		default:
+			printf("Failed to allocate memory\n");
+			break;
+		}
+		if (nResult != RLS_PACK_OK)
+			remove(pszOut);
+	}
+	for (nInput = 0; ptMaps && ptItems && nInput < nInputs; nInput++)
+	{
+		RLS_FileMap_Close(&ptMaps[nInput]);
+		free((char*)ptItems[nInput].pszName);
+	}
+	free(ptItems);
+	free(ptMaps);
+	return (nResult == RLS_PACK_OK) ? 0 : 1;
+}
+
+int RLS_Main_ListPack(const char* pszIn)
+{
+	RLSPack_T tPack;
+	int nEntry;
+
+	if (!RLS_Pack_Open(&tPack, pszIn))
+	{
+		printf("%s is not a pack\n", pszIn);
+		return 1;
+	}
+	for (nEntry = 0; nEntry < tPack.nEntries; nEntry++)
+	{
+		const RLSPackEntry_T* ptEntry = &tPack.ptEntries[nEntry];
+		printf("%s: %dx%d, %d frames, %lu bytes at %08lX\n",
+			   RLS_Pack_GetName(&tPack, ptEntry), ptEntry->wWidth,
+			   ptEntry->wHeight, ptEntry->wFrames,
+			   (unsigned long)ptEntry->nSize,
+			   (unsigned long)ptEntry->nOffset);
+	}
+	printf("%d images\n", tPack.nEntries);
+	RLS_Pack_Close(&tPack);
+	return 0;
+}
+
+int RLS_Main_Edit(char cOp, int nFrame, int nSrcFrame, const char* pszOut,
+				  char** apszIn, int nInputs, bool bIndex)
+{
+	RLSFileMap_T* ptMaps;
+	RLSEdit_T* ptEdit;
+	FILE* pOut = NULL;
+	char* pszTemp = NULL;
+	int nInput = 0, nOpened = 0, nDepend = 0;
+	int nResult = RLS_EDIT_OK;
+
+	ptMaps = (RLSFileMap_T*)calloc(nInputs, sizeof(RLSFileMap_T));
+	ptEdit = (RLSEdit_T*)malloc(sizeof(RLSEdit_T));
+	pszTemp = (char*)malloc(strlen(pszOut) + 8);
+	if (!ptMaps || !ptEdit || !pszTemp)
+	{
+		printf("Failed to allocate memory\n");
+		free(pszTemp);
+		free(ptEdit);
+		free(ptMaps);
+		return 1;
+	}
+	for (nOpened = 0; nOpened < nInputs; nOpened++)
+		if (!RLS_FileMap_Open(&ptMaps[nOpened], apszIn[nOpened]))
+		{
+			printf("Failed to open file %s\n", apszIn[nOpened]);
+			break;
+		}
+
+	/* the frames stay in the mappings, only their places change */
+	RLS_Edit_Init(ptEdit);
+	for (nInput = 0; nOpened == nInputs && nInput < nInputs; nInput++)
+	{
+		if (cOp == 'r' && nInput == 1)
+		{
+			nResult = RLS_Edit_Delete(ptEdit, nFrame, 1);
+			if (nResult != RLS_EDIT_OK)
+			{
+				nInput = 0; /* the frame replaced is missing */
+				break;
+			}
+			nResult = RLS_Edit_Insert(ptEdit, nFrame, ptMaps[1].pData,
+									  ptMaps[1].nSize, nSrcFrame, 1);
+		}
+		else
+			nResult = RLS_Edit_Insert(ptEdit, ptEdit->nFrames,
+									  ptMaps[nInput].pData,
+									  ptMaps[nInput].nSize, 0, -1);
+		if (nResult == RLS_EDIT_OK && cOp == 'x')
+			nResult = RLS_Edit_Delete(ptEdit, nFrame, 1);
+		if (nResult != RLS_EDIT_OK)
+			break;
+	}
+	/* alpha blocks would show another frame through */
+	if (nOpened == nInputs && nResult == RLS_EDIT_OK)
+		nResult = RLS_Edit_Check(ptEdit, &nDepend);
+	if (nOpened == nInputs && nResult == RLS_EDIT_OK)
+	{
+		/* written beside the output, which may be one of the inputs */
+		sprintf(pszTemp, "%s.tmp", pszOut);
+		pOut = fopen(pszTemp, "wb");
+		if (!pOut)
+			printf("Failed to open file %s\n", pszTemp);
+		else
+		{
+			nResult = RLS_Edit_Write(ptEdit, pOut, bIndex);
+			if (fclose(pOut) != 0 && nResult == RLS_EDIT_OK)
+				nResult = RLS_EDIT_EWRITE;
+		}
+	}
+	while (nOpened > 0)
+		RLS_FileMap_Close(&ptMaps[--nOpened]);
+	if (pOut && nResult == RLS_EDIT_OK)
+	{
+		remove(pszOut);
+		if (rename(pszTemp, pszOut) != 0)
+			nResult = RLS_EDIT_EWRITE;
+	}
+	switch (nResult)
+	{
+	case RLS_EDIT_OK:
+		if (pOut)
+			printf("Wrote %d frames to %s\n", ptEdit->nFrames, pszOut);
+		break;
+	case RLS_EDIT_EIMAGE:
+		printf("%s is not an RLS image\n", apszIn[nInput]);
+		break;
+	case RLS_EDIT_ESIZE:
+		printf("%s has different dimensions\n", apszIn[nInput]);
+		break;
+	case RLS_EDIT_EFRAMES:
+		printf("More than %d frames\n", UINT8_MAX);
+		break;
+	case RLS_EDIT_ERANGE:
+		printf("No frame %d in %s\n", (cOp == 'r' && nInput == 1) ?
+			   nSrcFrame : nFrame, apszIn[nInput]);
+		break;
+	case RLS_EDIT_EEMPTY:
+		printf("No frames would be left\n");
+		break;
+	case RLS_EDIT_EDEPEND:
+		printf("Frame %d draws over the frame before it, which the edit "
+			   "changes\n", nDepend);
+		break;
+	case RLS_EDIT_EMEMORY:
+		printf("Failed to allocate memory\n");
+		break;
+	default:
+		printf("Failed to write file %s\n", pszOut);
+		break;
+	}
+	if (pOut && nResult != RLS_EDIT_OK)
+		remove(pszTemp);
+	nResult = (pOut && nResult == RLS_EDIT_OK) ? 0 : 1;
+	free(pszTemp);
+	free(ptEdit);
+	free(ptMaps);
+	return nResult;
+}
+
+int RLS_Main_Optimize(const char* pszIn, int nThreads, bool bNoIndex)
+{
+	RLSFileMap_T tMap;
+	RLSOptimize_T* ptOpt;
+	FILE* pOut = NULL;
+	char* pszTemp;
+	size_t nOldSize, nNewSize;
+	bool bIndex;
+	int nResult = RLS_EDIT_OK;
+
+	ptOpt = (RLSOptimize_T*)malloc(sizeof(RLSOptimize_T));
+	pszTemp = (char*)malloc(strlen(pszIn) + 8);
+	if (!ptOpt || !pszTemp)
+	{
+		printf("Failed to allocate memory\n");
+		free(pszTemp);
+		free(ptOpt);
+		return 1;
+	}
+	if (!RLS_FileMap_Open(&tMap, pszIn))
+	{
+		printf("Failed to open file %s\n", pszIn);
+		free(pszTemp);
+		free(ptOpt);
+		return 1;
+	}
+	if (!RLS_Optimize_Run(ptOpt, tMap.pData, tMap.nSize, nThreads))
+	{
+		printf("%s is not an RLS image\n", pszIn);
+		RLS_FileMap_Close(&tMap);
+		free(pszTemp);
+		free(ptOpt);
+		return 1;
+	}
+	nOldSize = tMap.nSize;
+	/* an index stays unless dropped, none is added */
+	bIndex = !bNoIndex
+		  && RLS_Common_GetFrameOffset(tMap.pData, tMap.nSize, 0) != 0;
+	nNewSize = RLS_Optimize_GetSize(ptOpt, bIndex);
+	if (nNewSize < nOldSize)
+	{
+		sprintf(pszTemp, "%s.tmp", pszIn);
+		pOut = fopen(pszTemp, "wb");
+		if (!pOut)
+			printf("Failed to open file %s\n", pszTemp);
+		else
+		{
+			nResult = RLS_Edit_Write(&ptOpt->tEdit, pOut, bIndex);
+			if (fclose(pOut) != 0 && nResult == RLS_EDIT_OK)
+				nResult = RLS_EDIT_EWRITE;
+		}
+	}
+	printf("%s: %d of %d frames re-encoded smaller", pszIn,
+		   ptOpt->nImproved, ptOpt->tEdit.nFrames);
+	if (ptOpt->nDependent)
+		printf(", %d drawn over the previous frame kept",
+			   ptOpt->nDependent);
+	printf("\n");
+	RLS_FileMap_Close(&tMap);
+	if (pOut && nResult == RLS_EDIT_OK)
+	{
+		remove(pszIn);
+		if (rename(pszTemp, pszIn) != 0)
+			nResult = RLS_EDIT_EWRITE;
+	}
+	if (nResult != RLS_EDIT_OK)
+	{
+		printf("Failed to write file %s\n", pszIn);
+		remove(pszTemp);
+	}
+	else if (pOut)
+		printf("  %lu -> %lu bytes\n", (unsigned long)nOldSize,
+			   (unsigned long)nNewSize);
+	else if (nNewSize >= nOldSize)
+		printf("  %lu bytes, left as it is\n", (unsigned long)nOldSize);
+	nResult = (nResult == RLS_EDIT_OK && (pOut || nNewSize >= nOldSize))
+			? 0 : 1;
+	RLS_Optimize_Free(ptOpt);
+	free(pszTemp);
+	free(ptOpt);
+	return nResult;
+}
+
+int RLS_Main_Dirty(uint8_t* pData, size_t nSize, int nFrames, int nWidth,
+				   int nHeight)
+{
+	uint16_t* pFrame;
+	RLSRect_T* ptRects;
+	uint64_t nChanged, nTotal = 0;
+	int nFrame, nRects, nRect;
+
+	/* frame 0 is drawn over a black screen */
+	pFrame = (uint16_t*)calloc((size_t)nWidth * nHeight, sizeof(uint16_t));
+	ptRects = (RLSRect_T*)malloc(RLS_DECODE_RECTS(nHeight)
+								 * sizeof(RLSRect_T));
+	if (!pFrame || !ptRects)
+	{
+		printf("Failed to allocate memory\n");
+		free(ptRects);
+		free(pFrame);
+		return 1;
+	}
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
+	{
+		if (!RLS_Decode_Dirty(pData, nSize, nFrame, pFrame, nWidth, ptRects,
+							  &nRects))
+		{
+			printf("Failed to decode frame %d\n", nFrame);
+			free(ptRects);
+			free(pFrame);
+			return 1;
+		}
+		nChanged = 0;
+		for (nRect = 0; nRect < nRects; nRect++)
+			nChanged += (uint64_t)ptRects[nRect].nWidth
+					  * ptRects[nRect].nHeight;
+		nTotal += nChanged;
+		printf("Frame %d: %d rectangles, %lu of %lu pixels\n", nFrame,
+			   nRects, (unsigned long)nChanged,
+			   (unsigned long)nWidth * nHeight);
+		for (nRect = 0; nRect < nRects; nRect++)
+			printf("  %d,%d %dx%d\n", ptRects[nRect].nX, ptRects[nRect].nY,
+				   ptRects[nRect].nWidth, ptRects[nRect].nHeight);
+	}
+	printf("Redrawn %lu%% of the pixels of every frame\n",
+		   (unsigned long)(nTotal * 100
+						   / ((uint64_t)nWidth * nHeight * nFrames)));
+	free(ptRects);
+	free(pFrame);
+	return 0;
+}
+
+int RLS_Main_Play(const char* pszIn, int nFps, int nRing, int nLoops,
+				  size_t nCacheBytes)
+{
+	RLSFileMap_T tMap;
+	RLSPlayer_T tPlayer;
+	RLSCache_T tCache;
+	RLSPlayerStats_T tStats;
+	uint16_t* pFrame;
+	uint8_t* pData;
+	uint64_t nStart, nDecodeUs, nNow, nDue;
+	uint32_t nPeriodUs = 1000000 / nFps;
+	int nFrames = 0, nWidth = 0, nHeight = 0;
+	int nFrame, nTick, nTicks, nShown = 1, nDropped = 0;
+
+	if (!RLS_FileMap_Open(&tMap, pszIn))
+	{
+		printf("Failed to open file %s\n", pszIn);
+		return 1;
+	}
+	pData = (uint8_t*)tMap.pData;
+	if (tMap.nSize >= 12)
+		RLS_Common_GetInfo(pData, &nFrames, &nWidth, &nHeight, NULL);
+	if (nFrames <= 0 || nWidth <= 0 || nHeight <= 0)
+	{
+		printf("%s is not an RLS image\n", pszIn);
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	/* the cost the player hides: every frame decoded in turn */
+	pFrame = (uint16_t*)malloc((size_t)nWidth * nHeight * sizeof(uint16_t));
+	if (!pFrame)
+	{
+		printf("Failed to allocate memory\n");
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	nStart = RLS_Thread_GetTime();
+	for (nFrame = 0; nFrame < nFrames; nFrame++)
+		RLS_Decode(pData, tMap.nSize, nFrame, pFrame, nWidth);
+	nDecodeUs = RLS_Thread_GetTime() - nStart;
+	free(pFrame);
+
+	if (nCacheBytes && !RLS_Cache_Init(&tCache, nCacheBytes))
+	{
+		printf("Failed to allocate memory\n");
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	if (!RLS_Player_Open(&tPlayer, pData, tMap.nSize, nRing, nLoops > 1,
+						 nPeriodUs, nCacheBytes ? &tCache : NULL))
+	{
+		printf("Failed to start playing %s\n", pszIn);
+		if (nCacheBytes)
+			RLS_Cache_Free(&tCache);
+		RLS_FileMap_Close(&tMap);
+		return 1;
+	}
+	/* the first frame is waited for, later ones are due once a period */
+	RLS_Player_GetFrame(&tPlayer, 0, true);
+	nStart = RLS_Thread_GetTime();
+	nTicks = nFrames * nLoops;
+	for (nTick = 1; nTick < nTicks; nTick++)
+	{
+		nDue = nStart + (uint64_t)nTick * nPeriodUs;
+		nNow = RLS_Thread_GetTime();
+		if (nNow < nDue)
+			RLS_Thread_Sleep((uint32_t)(nDue - nNow));
+		if (RLS_Player_GetFrame(&tPlayer, nTick % nFrames, false))
+			nShown++;
+		else
+			nDropped++;
+	}
+	RLS_Player_GetStats(&tPlayer, &tStats);
+	RLS_Player_Close(&tPlayer);
+	RLS_FileMap_Close(&tMap);
+
+	printf("%s: %dx%d, %d frames at %d fps, ring of %d\n", pszIn, nWidth,
+		   nHeight, nFrames, nFps, nRing);
+	printf("  %d shown, %d dropped (not decoded in time)\n", nShown,
+		   nDropped);
+	printf("  jitter %lu us mean, %lu us max\n",
+		   (unsigned long)(tStats.nGets > 1 ?
+		   tStats.nJitterUs / (tStats.nGets - 1) : 0),
+		   (unsigned long)tStats.nMaxJitterUs);
+	printf("  decode %lu us per frame on one thread (%lu fps at most)\n",
+		   (unsigned long)(nDecodeUs / nFrames),
+		   (unsigned long)(nDecodeUs ? (uint64_t)nFrames * 1000000
+										/ nDecodeUs : 0));
+	if (nCacheBytes)
+	{
+		printf("  cache %lu hits, %lu misses, %lu evictions\n",
+			   (unsigned long)tCache.nHits, (unsigned long)tCache.nMisses,
+			   (unsigned long)tCache.nEvictions);
+		RLS_Cache_Free(&tCache);
+	}
+	return 0;
+}
+
+void RLS_Main_Usage(const char* pszProg)
+{
+	printf("Usage: %s -d [options] <input>\n", pszProg);
+	printf("       %s -e [options] <output> <input1> [input2 ...]\n",
+		   pszProg);
+	printf("       %s -e [options] -r rgb565|rgb24 -g <width>x<height>\n"
+		   "          <output> [input|-]\n", pszProg);
+	printf("       %s -e [options] -a <width>x<height> [-c <count>]\n"
+		   "          [-p <padding>] <output> <sheet>\n", pszProg);
+	printf("       %s -s [-t <threads>] [-p <profile>] <blob> [directory]\n",
+		   pszProg);
+	printf("       %s -k <pack> <input1.rls> [input2.rls ...]\n", pszProg);
+	printf("       %s -k -l <pack>\n", pszProg);
+	printf("       %s -c [-n] -a <image.rls> <input1.rls> [input2.rls ...]\n",
+		   pszProg);
+	printf("       %s -c [-n] -r <frame> <image.rls> <input.rls> [frame]\n",
+		   pszProg);
+	printf("       %s -c [-n] -x <frame> <image.rls>\n", pszProg);
+	printf("       %s -c [-n] -j <output.rls> <input1.rls> [input2.rls ...]\n",
+		   pszProg);
+	printf("       %s -p [-f <fps>] [-r <ring>] [-l <loops>] [-c <bytes>]\n"
+		   "          <input1.rls> [input2.rls ...]\n", pszProg);
+	printf("       %s -o [-n] [-t <threads>] <input1.rls> [input2.rls ...]\n",
+		   pszProg);
+	printf("Encode inputs: png, bmp, ppm/pgm/pnm/pam, rgb565/rgb24 (raw,\n"
+		   "with -g)\n");
+	printf("Encode options:\n");
+	printf("  -q none|rpza|pal|both  quantizer (default rpza); pal reduces\n"
+		   "                         each frame to the 256 standard palette\n"
+		   "                         colors\n");
+	printf("  -m <tolerance>         merge near-identical pixels inside 2x2\n"
+		   "                         blocks (per-channel, 0-255) so they are\n"
+		   "                         stored as reused pixels\n");
+	printf("  -s <tolerance>         snap pixels missing from the standard\n"
+		   "                         palette to its nearest color within the\n"
+		   "                         tolerance (per-channel, 0-255)\n");
+	printf("  -r rgb565|rgb24        read frames from a raw stream (file or\n"
+		   "                         stdin) instead of image files; rgb565 is\n"
+		   "                         little-endian, rgb24 is R, G, B\n");
+	printf("  -g <width>x<height>    frame size of raw streams and images\n");
+	printf("  -a <width>x<height>    slice frames of this size from one\n"
+		   "                         sprite sheet, left to right, top to\n"
+		   "                         bottom\n");
+	printf("  -c <count>             sprite sheet frames (default: every\n"
+		   "                         whole cell)\n");
+	printf("  -p <padding>           pixels between sprite sheet cells\n");
+	printf("  -n                     do not append a frame index (random\n"
+		   "                         frame access walks earlier frames)\n");
+	printf("  -b <bytes>             keep the output within this size:\n"
+		   "                         image files only, -m and -s are\n"
+		   "                         searched for the best quality that\n"
+		   "                         fits\n");
+	printf("  -t <threads>           threads searching for -b (default: one\n"
+		   "                         per CPU)\n");
+	printf("  -k <directory>         reuse frames encoded before with the\n"
+		   "                         same pixels and options from this cache\n"
+		   "                         directory, storing new ones (not with\n"
+		   "                         -b)\n");
+	printf("Decode options:\n");
+	printf("  -p store|fast|max      PNG export profile (default max);\n"
+		   "                         fast is deflate level 1, Paeth filter\n");
+	printf("  -f <f1,f2,...>         PNG row filters to choose from: none,\n"
+		   "                         sub, up, avg, paeth, all\n");
+	printf("  -i                     write frames with at most 256 colors as\n"
+		   "                         indexed PNGs\n");
+	printf("  -r rgb565|rgb24|rgba|ppm|pam\n"
+		   "                         write all frames uncompressed to one\n"
+		   "                         stream instead of one PNG per frame\n");
+	printf("  -x                     list the rectangles each frame changes\n"
+		   "                         instead of exporting\n");
+	printf("  -w <file>              stream file (default <input>.<format>,\n"
+		   "                         - for stdout)\n");
+	printf("  -t <threads>           threads writing PNGs, shared between\n"
+		   "                         frames and the strips of large frames\n"
+		   "                         (default: one per CPU, 1 - off)\n");
+	printf("Scan (-s) finds every RLS image inside a binary, such as a\n"
+		   "firmware dump, and writes each as <offset>.rls plus\n"
+		   "<offset>_<frame>.png (offset in hex) to the directory (default\n"
+		   "<blob>_rls); -t and -p work as for decoding.\n");
+	printf("Pack (-k) puts RLS images into one resource pack, named after\n"
+		   "their files without directory and extension; -l lists one.\n");
+	printf("Edit (-c) splices encoded frames without re-encoding: -a\n"
+		   "appends the frames of the inputs, -r replaces a frame with one\n"
+		   "of the input (default 0), -x deletes a frame, -j joins the\n"
+		   "inputs into a new image. Frames count from 0; -n drops the\n"
+		   "frame index. An edit is refused when a frame drawn over the\n"
+		   "one before it would end up over another frame.\n");
+	printf("Play (-p) plays RLS images at -f frames per second (default\n"
+		   "30) -l times (default 1) while a thread decodes the next -r\n"
+		   "frames (default %d) ahead, then reports dropped frames and\n"
+		   "jitter against the cost of decoding on one thread. -c keeps\n"
+		   "up to <bytes> of decoded frames, so later loops copy them.\n",
+		   RLS_PLAYER_RING);
+	printf("Optimize (-o) decodes every frame and encodes it again without\n"
+		   "quantizing, with the standard palette that stores it in the\n"
+		   "fewest bytes, on -t threads (default: one per CPU). An image\n"
+		   "is only rewritten when it gets smaller and every frame still\n"
+		   "decodes to the same pixels; -n drops the frame index.\n");
+}
+
 int main(int argc, char* argv[])
 {
 	if (argc >= 2)
 	{
-		char szFn[256];
 		if (strcmp(argv[1], "-d") == 0)
 		{
-			FILE* pFile = fopen(argv[2], "rb");
+			FILE* pFile;
+			const char* pszIn;
 			uint8_t* pData;
-			uint16_t* pDec;
 			int nSize;
 			int nWidth = 0, nHeight = 0, nFrames = 0;
 			int nCurrFrame;
+			int nThreads = 0, nWorkers;
+			int nResult;
+			int nFormat = -1; /* RLS_EXPF_*, -1 - PNG files */
+			const char* pszOut = NULL;
+			char* pszStream = NULL;
+			FILE* pMsg = stdout;
+			bool bDirty = false;
+			int nArg = 2;
+			while (nArg < argc && argv[nArg][0] == '-')
+			{
+				if (strcmp(argv[nArg], "-p") == 0 && nArg + 1 < argc)
+				{
+					if (!RLS_Main_PNGProfile(argv[nArg + 1]))
+						return 1;
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-f") == 0 && nArg + 1 < argc)
+				{
+					int nFilters = RLS_Main_PNGFilters(argv[nArg + 1]);
+					if (!nFilters)
+					{
+						printf("Unknown PNG filters %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					RLS_Convert_SetPNGFilters(nFilters);
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-i") == 0)
+				{
+					RLS_Convert_SetPNGIndexed(true);
+					nArg++;
+				}
+				else if (strcmp(argv[nArg], "-x") == 0)
+				{
+					bDirty = true;
+					nArg++;
+				}
+				else if (strcmp(argv[nArg], "-t") == 0 && nArg + 1 < argc)
+				{
+					nThreads = atoi(argv[nArg + 1]);
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-r") == 0 && nArg + 1 < argc)
+				{
+					int nCount = sizeof(RLS_Main_StreamFmts)
+							   / sizeof(RLS_Main_StreamFmts[0]);
+					for (nFormat = 0; nFormat < nCount; nFormat++)
+						if (_stricmp(argv[nArg + 1],
+									 RLS_Main_StreamFmts[nFormat]) == 0)
+							break;
+					if (nFormat == nCount)
+					{
+						printf("Unknown stream format %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-w") == 0 && nArg + 1 < argc)
+				{
+					pszOut = argv[nArg + 1];
+					nArg += 2;
+				}
+				else
+				{
+					printf("Unknown option %s\n", argv[nArg]);
+					return 1;
+				}
+			}
+			if (nArg >= argc)
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			pszIn = argv[nArg];
+			pFile = fopen(pszIn, "rb");
 			if (!pFile)
 			{
-				printf("Failed to open file %s\n", argv[2]);
+				printf("Failed to open file %s\n", pszIn);
 				return 1;
 			}
 			fseek(pFile, 0, SEEK_END);
@@ -106,58 +1390,295 @@ int main(int argc, char* argv[])
 			RLS_Common_GetInfo(pData, &nFrames, &nWidth, &nHeight, NULL);
 			if (nFrames == 0 || nWidth == 0 || nHeight == 0)
 			{
-				printf("Failed to get info from file %s\n", argv[2]);
+				printf("Failed to get info from file %s\n", pszIn);
 				return 1;
 			}
-			printf("Width: %d, Height: %d, Frames: %d\n",
-				   nWidth,nHeight,nFrames);
-			
-			pDec = (uint16_t*)malloc(nWidth * nHeight * sizeof(uint16_t));
-			if (!pDec)
+			/* keep stdout clean when the frames go there */
+			if (nFormat >= 0 && pszOut && strcmp(pszOut, "-") == 0)
+				pMsg = stderr;
+			fprintf(pMsg, "Width: %d, Height: %d, Frames: %d\n",
+					nWidth, nHeight, nFrames);
+			if (bDirty)
 			{
-				printf("Failed to allocate memory\n");
-				return 1;
+				nResult = RLS_Main_Dirty(pData, nSize, nFrames, nWidth,
+										 nHeight);
+				free(pData);
+				return nResult;
 			}
-			for (nCurrFrame = 0; nCurrFrame < nFrames; nCurrFrame++)
+
+			if (nFormat >= 0)
 			{
-				if (RLS_Decode(pData, nCurrFrame, pDec) == false)
+				if (pMsg == stderr)
 				{
-					printf("Failed to decode frame %d\n", nCurrFrame);
-					return 1;
+#ifdef _WIN32
+					_setmode(_fileno(stdout), _O_BINARY);
+#endif
+					pFile = stdout;
 				}
-				sprintf(szFn, "%s_%d.png", argv[2], nCurrFrame);
-				if (RLS_Convert_565toPNG(pDec,szFn,nWidth,nHeight)==false)
+				else
 				{
-					printf("Failed to convert frame %d\n", nCurrFrame);
-					return 1;
+					if (!pszOut)
+					{
+						pszStream = (char*)malloc(strlen(pszIn) + 8);
+						if (!pszStream)
+						{
+							printf("Failed to allocate memory\n");
+							return 1;
+						}
+						sprintf(pszStream, "%s.%s", pszIn,
+								RLS_Main_StreamFmts[nFormat]);
+						pszOut = pszStream;
+					}
+					pFile = fopen(pszOut, "wb");
+					if (!pFile)
+					{
+						printf("Failed to open file %s\n", pszOut);
+						return 1;
+					}
 				}
+				nResult = RLS_Export_Stream(pData, nSize, pFile,
+											(RLS_EXPF_E)nFormat, &nCurrFrame);
+				if (pFile != stdout)
+					fclose(pFile);
+				free(pszStream);
+			}
+			else
+			{
+				/* frames are written concurrently, the threads left over go
+				   to the strips of each frame */
+				if (nThreads <= 0)
+					nThreads = RLS_Thread_GetCPUs();
+				nWorkers = (nThreads < nFrames) ? nThreads : nFrames;
+				RLS_Convert_SetPNGThreads((nThreads / nWorkers > 1) ?
+										  nThreads / nWorkers : 1);
+				nResult = RLS_Export_PNGs(pData, nSize, pszIn, nWorkers,
+										  &nCurrFrame);
 			}
-			free(pDec);
+			switch (nResult)
+			{
+			case RLS_EXPORT_OK:
+				break;
+			case RLS_EXPORT_EDECODE:
+				fprintf(pMsg, "Failed to decode frame %d\n", nCurrFrame);
+				return 1;
+			case RLS_EXPORT_ECONVERT:
+				fprintf(pMsg, "Failed to convert frame %d\n", nCurrFrame);
+				return 1;
+			case RLS_EXPORT_EWRITE:
+				fprintf(pMsg, "Failed to write frame %d\n", nCurrFrame);
+				return 1;
+			default:
+				fprintf(pMsg, "Failed to allocate memory\n");
+				return 1;
+			}
+			free(pData);
 		}
 		else if (strcmp(argv[1], "-e") == 0)
 		{
 			FILE* pFile;
-			uint8_t* pData;
 			uint8_t* pEnc;
 			uint16_t* pDec;
 			uint8_t* pCurrEnc;
-			int nSize;
 			int nWidth = 0, nHeight = 0;
-			int nFrames = argc - 3;
+			int nRawWidth = 0, nRawHeight = 0;
+			int nCellWidth = 0, nCellHeight = 0;
+			int nCellCount = 0, nCellPad = 0;
+			int nFrames;
 			int nCurrFrame;
 			int nSavingCalcSize = 0;
-			if (_stricmp(FileExt(argv[3]), "png") != 0)
+			int nArg = 2;
+			int nMergeTol = 0;
+			int nMergeSaved = 0;
+			int nStream = -1; /* RLS_EXPF_*, -1 - PNG files */
+			int nThreads = 0;
+			size_t nMaxSize = 0; /* 0 - no byte budget */
+			const char* pszCache = NULL;
+			int nResult;
+			bool bIndex = true;
+			uint32_t anOffsets[UINT8_MAX];
+			RLS_QM_E eQuant = RLS_QM_RPZA;
+			while (nArg < argc && argv[nArg][0] == '-')
+			{
+				if (strcmp(argv[nArg], "-q") == 0 && nArg + 1 < argc)
+				{
+					if (_stricmp(argv[nArg + 1], "none") == 0)
+						eQuant = RLS_QM_NONE;
+					else if (_stricmp(argv[nArg + 1], "rpza") == 0)
+						eQuant = RLS_QM_RPZA;
+					else if (_stricmp(argv[nArg + 1], "pal") == 0)
+						eQuant = RLS_QM_PAL;
+					else if (_stricmp(argv[nArg + 1], "both") == 0)
+						eQuant = RLS_QM_BOTH;
+					else
+					{
+						printf("Unknown quantizer %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-m") == 0 && nArg + 1 < argc)
+				{
+					nMergeTol = atoi(argv[nArg + 1]);
+					if (nMergeTol > RLS_DIFF_TOL_MAX)
+						nMergeTol = RLS_DIFF_TOL_MAX;
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-s") == 0 && nArg + 1 < argc)
+				{
+					RLS_Encode_SetSnap(atoi(argv[nArg + 1]));
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-r") == 0 && nArg + 1 < argc)
+				{
+					if (_stricmp(argv[nArg + 1], "rgb565") == 0)
+						nStream = RLS_EXPF_RGB565;
+					else if (_stricmp(argv[nArg + 1], "rgb24") == 0)
+						nStream = RLS_EXPF_RGB24;
+					else
+					{
+						printf("Unknown stream format %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-g") == 0 && nArg + 1 < argc)
+				{
+					if (sscanf(argv[nArg + 1], "%dx%d", &nRawWidth,
+							   &nRawHeight) != 2)
+					{
+						printf("Bad frame size %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-a") == 0 && nArg + 1 < argc)
+				{
+					if (sscanf(argv[nArg + 1], "%dx%d", &nCellWidth,
+							   &nCellHeight) != 2 || nCellWidth <= 0
+					 || nCellHeight <= 0 || nCellWidth > UINT16_MAX
+					 || nCellHeight > UINT16_MAX)
+					{
+						printf("Bad frame size %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-c") == 0 && nArg + 1 < argc)
+				{
+					nCellCount = atoi(argv[nArg + 1]);
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-p") == 0 && nArg + 1 < argc)
+				{
+					nCellPad = atoi(argv[nArg + 1]);
+					if (nCellPad < 0)
+						nCellPad = 0;
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-n") == 0)
+				{
+					bIndex = false;
+					nArg++;
+				}
+				else if (strcmp(argv[nArg], "-b") == 0 && nArg + 1 < argc)
+				{
+					nMaxSize = strtoul(argv[nArg + 1], NULL, 0);
+					if (!nMaxSize)
+					{
+						printf("Bad byte budget %s\n", argv[nArg + 1]);
+						return 1;
+					}
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-t") == 0 && nArg + 1 < argc)
+				{
+					nThreads = atoi(argv[nArg + 1]);
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-k") == 0 && nArg + 1 < argc)
+				{
+					pszCache = argv[nArg + 1];
+					nArg += 2;
+				}
+				else
+				{
+					printf("Unknown option %s\n", argv[nArg]);
+					return 1;
+				}
+			}
+			if (nMaxSize && (nStream >= 0 || nCellWidth > 0))
 			{
-				printf("File %s is not a PNG file\n", argv[3]);
+				printf("A byte budget (-b) needs image files\n");
 				return 1;
 			}
-			pDec = RLS_Convert_PNGto565(argv[3], &nWidth, &nHeight);
-			if (!pDec)
+			if (nMaxSize && pszCache)
+			{
+				printf("A byte budget (-b) does not use the cache (-k)\n");
+				return 1;
+			}
+			if (pszCache && (!RLS_Main_MakeDir(pszCache)
+						  || !RLS_ECache_Open(&RLS_Main_ECache, pszCache)))
+			{
+				printf("Failed to create directory %s\n", pszCache);
+				return 1;
+			}
+			if (nStream >= 0)
+			{
+				if (argc - nArg < 1 || argc - nArg > 2)
+				{
+					RLS_Main_Usage(argv[0]);
+					return 1;
+				}
+				if (nRawWidth <= 0 || nRawHeight <= 0
+				 || nRawWidth > UINT16_MAX || nRawHeight > UINT16_MAX)
+				{
+					printf("Raw streams need a frame size (-g)\n");
+					return 1;
+				}
+				nResult = RLS_Main_EncodeStream(argv[nArg], argv[nArg + 1],
+												(RLS_EXPF_E)nStream,
+												nRawWidth, nRawHeight,
+												eQuant, nMergeTol, bIndex);
+				RLS_Main_ECacheDone();
+				return nResult;
+			}
+			if (nCellWidth > 0)
 			{
-				printf("Failed to convert PNG file %s\n", argv[3]);
+				if (argc - nArg != 2)
+				{
+					RLS_Main_Usage(argv[0]);
+					return 1;
+				}
+				nResult = RLS_Main_EncodeAtlas(argv[nArg], argv[nArg + 1],
+											   nRawWidth, nRawHeight,
+											   nCellWidth, nCellHeight,
+											   nCellCount, nCellPad, eQuant,
+											   nMergeTol, bIndex);
+				RLS_Main_ECacheDone();
+				return nResult;
+			}
+			if (argc - nArg < 2)
+			{
+				RLS_Main_Usage(argv[0]);
 				return 1;
 			}
-			pEnc=(uint8_t*)malloc(12+(nFrames*RLS_ENCODE_BSIZE(nWidth,nHeight)));
+			nFrames = argc - nArg - 1;
+			if (nFrames > UINT8_MAX)
+			{
+				printf("More than %d frames\n", UINT8_MAX);
+				return 1;
+			}
+			if (nMaxSize)
+				return RLS_Main_EncodeBudget(argv[nArg], &argv[nArg + 1],
+											 nFrames, nRawWidth, nRawHeight,
+											 eQuant, bIndex, nMaxSize,
+											 nThreads);
+			pDec = RLS_Main_Import(argv[nArg + 1], nRawWidth, nRawHeight,
+								   &nWidth, &nHeight);
+			if (!pDec)
+				return 1;
+			pEnc=(uint8_t*)malloc(12+(nFrames*RLS_ENCODE_BSIZE(nWidth,nHeight))
+								  + RLS_INDEX_SIZE(nFrames));
 			if (!pEnc)
 			{
 				printf("Failed to allocate memory\n");
@@ -168,47 +1689,218 @@ int main(int argc, char* argv[])
 			{
 				int nSize;
 				int nVW = nWidth, nVH = nHeight;
-				RLS_Quantize(pDec, nWidth, nHeight);
-				nSize = RLS_Encode(pDec, pCurrEnc, false, 0, nWidth, nHeight);
+				const char* pszIn = argv[nArg + 2 + nCurrFrame];
+				nSize = RLS_Main_EncodeFrame(pDec, pCurrEnc, nWidth, nHeight,
+											 nWidth, eQuant, nMergeTol,
+											 &nMergeSaved, nCurrFrame);
+				if (!nSize)
+				{
+					free(pDec);
+					free(pEnc);
+					return 1;
+				}
+				anOffsets[nCurrFrame] = (uint32_t)(pCurrEnc - pEnc);
 				pCurrEnc += nSize;
 				nSavingCalcSize += nSize-(2*sizeof(uint32_t));
 				free(pDec);
 				if (nCurrFrame == nFrames - 1)
 					break;
-				if (_stricmp(FileExt(argv[4+nCurrFrame]), "png") != 0)
-				{
-					printf("File %s is not a PNG file\n", argv[4+nCurrFrame]);
-					return 1;
-				}
-				pDec = RLS_Convert_PNGto565(argv[4+nCurrFrame], &nWidth, &nHeight);
+				pDec = RLS_Main_Import(pszIn, nRawWidth, nRawHeight,
+									   &nWidth, &nHeight);
 				if (!pDec)
-				{
-					printf("Failed to convert PNG file %s\n",argv[4+nCurrFrame]);
 					return 1;
-				}
 				if (nVW != nWidth || nVH != nHeight)
 				{
-					printf("%s has different dimensions\n",argv[4+nCurrFrame]);
+					printf("%s has different dimensions\n", pszIn);
 					return 1;
 				}
 			}
 			RLS_Common_MakeInfo(pEnc, nFrames, nWidth, nHeight,
 			RLS_CALC_SAVING((nWidth*nHeight*nFrames), nSavingCalcSize), false);
-			pFile = fopen(argv[2], "wb");
+			if (bIndex)
+				pCurrEnc += RLS_Common_MakeIndex(pCurrEnc, anOffsets, nFrames);
+			pFile = fopen(argv[nArg], "wb");
 			if (!pFile)
 			{
-				printf("Failed to open file %s\n", argv[2]);
+				printf("Failed to open file %s\n", argv[nArg]);
 				return 1;
 			}
 			fwrite(pEnc, 1, pCurrEnc-pEnc, pFile);
 			fclose(pFile);
 			free(pEnc);
+			RLS_Main_ECacheDone();
+			if (nMergeTol > 0)
+				printf("Block merge saved %s%d bytes\n",
+					   (eQuant & RLS_QM_PAL) ? "" : "at least ", nMergeSaved);
+		}
+		else if (strcmp(argv[1], "-s") == 0)
+		{
+			char* pszDir = NULL;
+			int nThreads = 0;
+			int nResult;
+			int nArg = 2;
+			while (nArg < argc && argv[nArg][0] == '-')
+			{
+				if (strcmp(argv[nArg], "-t") == 0 && nArg + 1 < argc)
+				{
+					nThreads = atoi(argv[nArg + 1]);
+					nArg += 2;
+				}
+				else if (strcmp(argv[nArg], "-p") == 0 && nArg + 1 < argc)
+				{
+					if (!RLS_Main_PNGProfile(argv[nArg + 1]))
+						return 1;
+					nArg += 2;
+				}
+				else
+				{
+					printf("Unknown option %s\n", argv[nArg]);
+					return 1;
+				}
+			}
+			if (argc - nArg < 1 || argc - nArg > 2)
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			if (argc - nArg == 1)
+			{
+				pszDir = (char*)malloc(strlen(argv[nArg]) + 8);
+				if (!pszDir)
+				{
+					printf("Failed to allocate memory\n");
+					return 1;
+				}
+				sprintf(pszDir, "%s_rls", argv[nArg]);
+			}
+			nResult = RLS_Main_Scan(argv[nArg], pszDir ? pszDir
+									: argv[nArg + 1], nThreads);
+			free(pszDir);
+			return nResult;
+		}
+		else if (strcmp(argv[1], "-k") == 0)
+		{
+			if (argc == 4 && strcmp(argv[2], "-l") == 0)
+				return RLS_Main_ListPack(argv[3]);
+			if (argc < 4 || argv[2][0] == '-')
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			return RLS_Main_Pack(argv[2], &argv[3], argc - 3);
+		}
+		else if (strcmp(argv[1], "-c") == 0)
+		{
+			bool bIndex = true;
+			int nArg = 2;
+			int nFrame = 0, nSrcFrame = 0;
+			char cOp;
+			if (nArg < argc && strcmp(argv[nArg], "-n") == 0)
+			{
+				bIndex = false;
+				nArg++;
+			}
+			if (nArg >= argc || argv[nArg][0] != '-' || !argv[nArg][1]
+			 || argv[nArg][2] || !strchr("arxj", argv[nArg][1]))
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			cOp = argv[nArg++][1];
+			if ((cOp == 'r' || cOp == 'x') && nArg < argc)
+				nFrame = atoi(argv[nArg++]);
+			if (cOp == 'r' && argc - nArg == 3)
+				nSrcFrame = atoi(argv[--argc]);
+			if ((cOp == 'x') ? argc - nArg != 1 :
+				(cOp == 'r') ? argc - nArg != 2 : argc - nArg < 2)
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			/* -j writes a new image, the others edit the first input */
+			if (cOp == 'j')
+				return RLS_Main_Edit(cOp, 0, 0, argv[nArg], &argv[nArg + 1],
+									 argc - nArg - 1, bIndex);
+			return RLS_Main_Edit(cOp, nFrame, nSrcFrame, argv[nArg],
+								 &argv[nArg], argc - nArg, bIndex);
+		}
+		else if (strcmp(argv[1], "-p") == 0)
+		{
+			int nFps = 30;
+			int nRing = RLS_PLAYER_RING;
+			int nLoops = 1;
+			size_t nCacheBytes = 0;
+			int nResult = 0;
+			int nArg = 2;
+			while (nArg < argc && argv[nArg][0] == '-')
+			{
+				if (strcmp(argv[nArg], "-f") == 0 && nArg + 1 < argc)
+					nFps = atoi(argv[nArg + 1]);
+				else if (strcmp(argv[nArg], "-r") == 0 && nArg + 1 < argc)
+					nRing = atoi(argv[nArg + 1]);
+				else if (strcmp(argv[nArg], "-l") == 0 && nArg + 1 < argc)
+					nLoops = atoi(argv[nArg + 1]);
+				else if (strcmp(argv[nArg], "-c") == 0 && nArg + 1 < argc)
+					nCacheBytes = strtoul(argv[nArg + 1], NULL, 0);
+				else
+				{
+					printf("Unknown option %s\n", argv[nArg]);
+					return 1;
+				}
+				nArg += 2;
+			}
+			if (nArg >= argc || nFps <= 0 || nRing <= 0 || nLoops <= 0)
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			for (; nArg < argc; nArg++)
+				nResult |= RLS_Main_Play(argv[nArg], nFps, nRing, nLoops,
+										 nCacheBytes);
+			return nResult;
+		}
+		else if (strcmp(argv[1], "-o") == 0)
+		{
+			bool bNoIndex = false;
+			int nThreads = 0;
+			int nResult = 0;
+			int nArg = 2;
+			while (nArg < argc && argv[nArg][0] == '-')
+			{
+				if (strcmp(argv[nArg], "-n") == 0)
+				{
+					bNoIndex = true;
+					nArg++;
+				}
+				else if (strcmp(argv[nArg], "-t") == 0 && nArg + 1 < argc)
+				{
+					nThreads = atoi(argv[nArg + 1]);
+					nArg += 2;
+				}
+				else
+				{
+					printf("Unknown option %s\n", argv[nArg]);
+					return 1;
+				}
+			}
+			if (nArg >= argc)
+			{
+				RLS_Main_Usage(argv[0]);
+				return 1;
+			}
+			if (nThreads <= 0)
+				nThreads = RLS_Thread_GetCPUs();
+			for (; nArg < argc; nArg++)
+				nResult |= RLS_Main_Optimize(argv[nArg], nThreads, bNoIndex);
+			return nResult;
 		}
 		else
 		{
-			printf("Usage: %s -d/e <input>\n", argv[0]);
+			RLS_Main_Usage(argv[0]);
 			return 1;
 		}
 		return 0;
 	}
+	RLS_Main_Usage(argv[0]);
+	return 1;
 }
\ No newline at end of file
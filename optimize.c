@@ -0,0 +1,467 @@
+/*
+** ===========================================================================
+** File: optimize.c
+** Description: ReakoLite library lossless re-encoder code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_EXTERN_VAR
+#include "common.h"
+#include "decode.h"
+#include "encode.h"
+#include "optimize.h"
+#include "thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_OPTIMIZE_COLORS (UINT16_MAX + 1)
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSOptimizeJob_T RLSOptimizeJob_T;
+
+typedef struct tagRLSOptimizeJob_T
+{
+	RLSOptimize_T* ptOpt;
+	uint8_t* pIn;
+	size_t nSize;
+	RLS_Mutex_T tMutex;
+	int nNext; /* next frame for a worker */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_CmpKey
+**
+** Description:
+**     qsort callback, orders count/color keys from the largest
+**
+** Input:
+**     pA - Key
+**     pB - Key
+**
+** Output:
+**     none
+**
+** Return value:
+**     <0/0/>0
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Optimize_CmpKey(const void* pA, const void* pB)
+{
+	uint64_t nA = *(const uint64_t*)pA;
+	uint64_t nB = *(const uint64_t*)pB;
+	return (nA < nB) - (nA > nB);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_Palette
+**
+** Description:
+**     Builds the standard palette that stores a frame in the fewest bytes.
+**     A block stores each of its distinct colors once, as a one byte index
+**     or as a two byte extended palette color, so the colors stored most
+**     often go to the standard palette.
+**
+** Input:
+**     pImg - Frame
+**     nWidth - Width
+**     nHeight - Height
+**     anCounts - RLS_OPTIMIZE_COLORS counters
+**     anKeys - RLS_OPTIMIZE_COLORS keys
+**     awPal - Palette
+**
+** Output:
+**     Palette
+**
+** Return value:
+**     Palette colors
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Optimize_Palette(uint16_t* pImg, int nWidth, int nHeight,
+								uint32_t* anCounts, uint64_t* anKeys,
+								uint16_t* awPal)
+{
+	int nCols = RLS_CEIL(nWidth, 2);
+	int nRows = RLS_CEIL(nHeight, 2);
+	int nCurrCol, nCurrRow, nBkPix, nColor, nColors = 0;
+
+	memset(anCounts, 0, RLS_OPTIMIZE_COLORS * sizeof(uint32_t));
+	for (nCurrRow = 0; nCurrRow < nRows; nCurrRow++)
+	{
+		for (nCurrCol = 0; nCurrCol < nCols; nCurrCol++)
+		{
+			if (RLS_Common_ExtractBlock(pImg, nWidth, nHeight, nWidth,
+										nCurrCol, nCurrRow) == false)
+				return 0;
+			for (nBkPix = 0; nBkPix < 2*2; nBkPix++)
+			{
+				uint16_t wColor = RLS_Common_Block[nBkPix];
+				/* repeats inside the block cost nothing */
+				if ((nBkPix > 0 && RLS_Common_Block[0] == wColor)
+				 || (nBkPix > 1 && RLS_Common_Block[1] == wColor)
+				 || (nBkPix > 2 && RLS_Common_Block[2] == wColor))
+					continue;
+				anCounts[wColor]++;
+			}
+		}
+	}
+	for (nColor = 0; nColor < RLS_OPTIMIZE_COLORS; nColor++)
+		if (anCounts[nColor])
+			anKeys[nColors++] = ((uint64_t)anCounts[nColor] << 16) | nColor;
+	/* the color breaks ties, so the palette does not depend on the run */
+	qsort(anKeys, nColors, sizeof(uint64_t), RLS_Optimize_CmpKey);
+	if (nColors > RLS_SPAL_SIZE)
+		nColors = RLS_SPAL_SIZE;
+	for (nColor = 0; nColor < nColors; nColor++)
+		awPal[nColor] = (uint16_t)anKeys[nColor];
+	return nColors;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_Frame
+**
+** Description:
+**     Re-encodes a frame with the palette of RLS_Optimize_Palette and keeps
+**     the result if it is smaller and decodes to the same pixels. Frames
+**     whose pixels depend on what was drawn before them are left alone.
+**
+** Input:
+**     ptJob - Job
+**     nFrame - Frame
+**     pOrig - Frame sized buffer
+**     pCheck - Frame sized buffer
+**     pEnc - 12 + RLS_ENCODE_BSIZE bytes
+**     anCounts - RLS_OPTIMIZE_COLORS counters
+**     anKeys - RLS_OPTIMIZE_COLORS keys
+**
+** Output:
+**     Re-encoded frame in ptJob->ptOpt
+**
+** Return value:
+**     true/false (out of memory)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Optimize_Frame(RLSOptimizeJob_T* ptJob, int nFrame,
+							   uint16_t* pOrig, uint16_t* pCheck,
+							   uint8_t* pEnc, uint32_t* anCounts,
+							   uint64_t* anKeys)
+{
+	RLSOptimize_T* ptOpt = ptJob->ptOpt;
+	int nWidth = ptOpt->tEdit.nWidth;
+	int nHeight = ptOpt->tEdit.nHeight;
+	size_t nPixels = (size_t)nWidth * nHeight;
+	uint16_t awPal[RLS_SPAL_SIZE];
+	uint32_t nSize;
+	int nColors, nSnapTol, nPixel;
+
+	/* decoded over two different backgrounds, a frame drawing over the
+	   previous one shows through */
+	memset(pOrig, 0x00, nPixels * sizeof(uint16_t));
+	memset(pCheck, 0xFF, nPixels * sizeof(uint16_t));
+	if (!RLS_Decode(ptJob->pIn, ptJob->nSize, nFrame, pOrig, nWidth)
+	 || !RLS_Decode(ptJob->pIn, ptJob->nSize, nFrame, pCheck, nWidth)
+	 || memcmp(pOrig, pCheck, nPixels * sizeof(uint16_t)) != 0)
+	{
+		RLS_Mutex_Lock(&ptJob->tMutex);
+		ptOpt->nDependent++;
+		RLS_Mutex_Unlock(&ptJob->tMutex);
+		return true;
+	}
+
+	nColors = RLS_Optimize_Palette(pOrig, nWidth, nHeight, anCounts, anKeys,
+								   awPal);
+	/* lossless: no snapping, whatever this thread was set to */
+	nSnapTol = RLS_Encode_GetSnap();
+	RLS_Encode_SetSnap(0);
+	RLS_Encode_SetSPal(awPal, nColors);
+	nSize = RLS_Encode(pOrig, pEnc + 12, false, 0, nWidth, nHeight, nWidth);
+	RLS_Encode_SetSPal(NULL, 0);
+	RLS_Encode_SetSnap(nSnapTol);
+	if (!nSize || nSize >= ptOpt->tEdit.atFrames[nFrame].nSize)
+		return true;
+
+	/* a full extended palette falls back to nearest colors, catch that */
+	RLS_Common_MakeInfo(pEnc, 1, nWidth, nHeight, 0, false);
+	for (nPixel = 0; nPixel < (int)nPixels; nPixel++)
+		pCheck[nPixel] = ~pOrig[nPixel];
+	if (!RLS_Decode(pEnc, 12 + nSize, 0, pCheck, nWidth)
+	 || memcmp(pOrig, pCheck, nPixels * sizeof(uint16_t)) != 0)
+		return true;
+	ptOpt->apFrames[nFrame] = (uint8_t*)malloc(nSize);
+	if (!ptOpt->apFrames[nFrame])
+		return false;
+	memcpy(ptOpt->apFrames[nFrame], pEnc + 12, nSize);
+	/* each worker has frames of its own, only the count is shared */
+	ptOpt->tEdit.atFrames[nFrame].pData = ptOpt->apFrames[nFrame];
+	ptOpt->tEdit.atFrames[nFrame].nSize = nSize;
+	RLS_Mutex_Lock(&ptJob->tMutex);
+	ptOpt->nImproved++;
+	RLS_Mutex_Unlock(&ptJob->tMutex);
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_Worker
+**
+** Description:
+**     Thread taking frames to re-encode until none are left
+**
+** Input:
+**     pArg - Pointer to the job
+**
+** Output:
+**     Re-encoded frames
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Optimize_Worker(void* pArg)
+{
+	RLSOptimizeJob_T* ptJob = *(RLSOptimizeJob_T**)pArg;
+	const RLSEdit_T* ptEdit = &ptJob->ptOpt->tEdit;
+	size_t nPixels = (size_t)ptEdit->nWidth * ptEdit->nHeight;
+	uint16_t* pOrig = (uint16_t*)malloc(nPixels * sizeof(uint16_t));
+	uint16_t* pCheck = (uint16_t*)malloc(nPixels * sizeof(uint16_t));
+	uint8_t* pEnc = (uint8_t*)malloc(12 + RLS_ENCODE_BSIZE(ptEdit->nWidth,
+														   ptEdit->nHeight));
+	uint32_t* anCounts = (uint32_t*)malloc(RLS_OPTIMIZE_COLORS
+										   * sizeof(uint32_t));
+	uint64_t* anKeys = (uint64_t*)malloc(RLS_OPTIMIZE_COLORS
+										 * sizeof(uint64_t));
+
+	/* without buffers the other workers take over, frames left over
+	   stay as they are */
+	while (pOrig && pCheck && pEnc && anCounts && anKeys)
+	{
+		int nFrame;
+		RLS_Mutex_Lock(&ptJob->tMutex);
+		nFrame = ptJob->nNext++;
+		RLS_Mutex_Unlock(&ptJob->tMutex);
+		if (nFrame >= ptEdit->nFrames
+		 || !RLS_Optimize_Frame(ptJob, nFrame, pOrig, pCheck, pEnc,
+								anCounts, anKeys))
+			break;
+	}
+	free(anKeys);
+	free(anCounts);
+	free(pEnc);
+	free(pCheck);
+	free(pOrig);
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_Run
+**
+** Description:
+**     Re-encodes every frame of a container without quantizing, with the
+**     standard palette that suits it best, several frames at once. Frames
+**     that would not shrink keep their encoding.
+**
+** Input:
+**     ptOpt - Result
+**     pIn - Container, kept until RLS_Optimize_Free
+**     nSize - Container size
+**     nWorkers - Threads (1 - on the calling thread)
+**
+** Output:
+**     Result
+**
+** Return value:
+**     true/false (not a container)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Optimize_Run(RLSOptimize_T* ptOpt, const uint8_t* pIn,
+					  size_t nSize, int nWorkers)
+{
+	RLSOptimizeJob_T tJob;
+	RLSOptimizeJob_T* aptJobs[RLS_THREAD_MAX];
+	int nWorker;
+
+	if (!ptOpt)
+		return false;
+	memset(ptOpt, 0, sizeof(RLSOptimize_T));
+	RLS_Edit_Init(&ptOpt->tEdit);
+	if (RLS_Edit_Insert(&ptOpt->tEdit, 0, pIn, nSize, 0, -1) != RLS_EDIT_OK)
+		return false;
+	memset(&tJob, 0, sizeof(tJob));
+	tJob.ptOpt = ptOpt;
+	tJob.pIn = (uint8_t*)pIn;
+	tJob.nSize = nSize;
+	if (!RLS_Mutex_Init(&tJob.tMutex))
+		return true; /* nothing improved */
+	if (nWorkers > ptOpt->tEdit.nFrames)
+		nWorkers = ptOpt->tEdit.nFrames;
+	if (nWorkers > RLS_THREAD_MAX)
+		nWorkers = RLS_THREAD_MAX;
+	if (nWorkers < 1)
+		nWorkers = 1;
+	for (nWorker = 0; nWorker < nWorkers; nWorker++)
+		aptJobs[nWorker] = &tJob;
+	RLS_Thread_Run(RLS_Optimize_Worker, aptJobs, sizeof(aptJobs[0]),
+				   nWorkers);
+	RLS_Mutex_Destroy(&tJob.tMutex);
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_GetSize
+**
+** Description:
+**     Gets the size RLS_Edit_Write gives the re-encoded container
+**
+** Input:
+**     ptOpt - Result
+**     bIndex - With a frame index
+**
+** Output:
+**     none
+**
+** Return value:
+**     Container size
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+size_t RLS_Optimize_GetSize(const RLSOptimize_T* ptOpt, bool bIndex)
+{
+	size_t nSize = 12;
+	int nFrame;
+	for (nFrame = 0; nFrame < ptOpt->tEdit.nFrames; nFrame++)
+		nSize += ptOpt->tEdit.atFrames[nFrame].nSize;
+	if (bIndex)
+		nSize += RLS_INDEX_SIZE(ptOpt->tEdit.nFrames);
+	return nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Optimize_Free
+**
+** Description:
+**     Frees the re-encoded frames
+**
+** Input:
+**     ptOpt - Result
+**
+** Output:
+**     Cleared result
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Optimize_Free(RLSOptimize_T* ptOpt)
+{
+	int nFrame;
+	if (!ptOpt)
+		return;
+	for (nFrame = 0; nFrame < UINT8_MAX; nFrame++)
+		free(ptOpt->apFrames[nFrame]);
+	memset(ptOpt, 0, sizeof(RLSOptimize_T));
+}
\ No newline at end of file
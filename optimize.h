@@ -0,0 +1,75 @@
+/*
+** ===========================================================================
+** File: optimize.h
+** Description: ReakoLite library lossless re-encoder header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_OPTIMIZE_H
+#define RLS_OPTIMIZE_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "edit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSOptimize_T RLSOptimize_T;
+
+/* re-encoded container, write it with RLS_Edit_Write(&tEdit) */
+typedef struct tagRLSOptimize_T
+{
+	RLSEdit_T tEdit; /* improved frames point into apFrames */
+	uint8_t* apFrames[UINT8_MAX]; /* re-encoded frames, NULL - kept */
+	int nImproved;
+	int nDependent; /* drawn over the previous frame, kept as they are */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_Optimize_Run(RLSOptimize_T* ptOpt, const uint8_t* pIn,
+							 size_t nSize, int nWorkers);
+extern size_t RLS_Optimize_GetSize(const RLSOptimize_T* ptOpt, bool bIndex);
+extern void RLS_Optimize_Free(RLSOptimize_T* ptOpt);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_OPTIMIZE_H
\ No newline at end of file
@@ -0,0 +1,579 @@
+/*
+** ===========================================================================
+** File: pack.c
+** Description: ReakoLite library resource pack code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "pack.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_PACK_FNV_BASIS 0x811C9DC5
+#define RLS_PACK_FNV_PRIME 0x01000193
+
+#define RLS_PACK_ALIGNED(n) \
+	(((n) + RLS_PACK_ALIGN - 1) & ~(size_t)(RLS_PACK_ALIGN - 1))
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_CmpItems
+**
+** Description:
+**     qsort comparison of pack items by name
+**
+** Input:
+**     pA - Item
+**     pB - Item
+**
+** Output:
+**     none
+**
+** Return value:
+**     strcmp of the names
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Pack_CmpItems(const void* pA, const void* pB)
+{
+	return strcmp(((const RLSPackItem_T*)pA)->pszName,
+				  ((const RLSPackItem_T*)pB)->pszName);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_WriteAll
+**
+** Description:
+**     Writes data padded with zeros to a multiple of RLS_PACK_ALIGN
+**
+** Input:
+**     pOut - Pack file
+**     pData - Data
+**     nSize - Data size
+**
+** Output:
+**     Written data
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Pack_WriteAll(FILE* pOut, const void* pData, size_t nSize)
+{
+	static const uint8_t abZero[RLS_PACK_ALIGN] = {0};
+	size_t nPad = RLS_PACK_ALIGNED(nSize) - nSize;
+	return fwrite(pData, 1, nSize, pOut) == nSize
+		&& fwrite(abZero, 1, nPad, pOut) == nPad;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Hash
+**
+** Description:
+**     Hashes an asset name (32-bit FNV-1a)
+**
+** Input:
+**     pszName - Name
+**     nLen - Name length
+**
+** Output:
+**     none
+**
+** Return value:
+**     Hash
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint32_t RLS_Pack_Hash(const char* pszName, size_t nLen)
+{
+	uint32_t nHash = RLS_PACK_FNV_BASIS;
+	size_t nPos;
+	for (nPos = 0; nPos < nLen; nPos++)
+	{
+		nHash ^= (uint8_t)pszName[nPos];
+		nHash *= RLS_PACK_FNV_PRIME;
+	}
+	return nHash;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Write
+**
+** Description:
+**     Writes RLS containers and their directory to a pack. The containers
+**     are copied as they are; anything after the end of a container (see
+**     RLS_Common_GetSize) is left out.
+**
+** Input:
+**     pOut - Pack file, written from its current position
+**     ptItems - Containers, sorted by name here
+**     nItems - Container count
+**     pnFailed - Item at fault on failure, may be NULL
+**
+** Output:
+**     Pack, items sorted and trimmed to their container size
+**
+** Return value:
+**     RLS_PACK_OK/RLS_PACK_E*
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Pack_Write(FILE* pOut, RLSPackItem_T* ptItems, int nItems,
+				   int* pnFailed)
+{
+	RLSPackHeader_T tHeader;
+	RLSPackEntry_T* ptEntries;
+	uint32_t* pnBuckets;
+	char* pszNames;
+	uint8_t* pDir;
+	size_t nNames = 0, nDirSize, nOffset;
+	uint32_t nBuckets = 1;
+	int nItem, nResult = RLS_PACK_OK;
+	int nFailed = 0;
+
+	if (!pnFailed)
+		pnFailed = &nFailed;
+	*pnFailed = -1;
+	if (!pOut || !ptItems || nItems <= 0)
+		return RLS_PACK_EIMAGE;
+	qsort(ptItems, nItems, sizeof(RLSPackItem_T), RLS_Pack_CmpItems);
+	for (nItem = 0; nItem < nItems; nItem++)
+	{
+		size_t nLen = strlen(ptItems[nItem].pszName);
+		if (!nLen || nLen > UINT16_MAX || (nItem && strcmp(
+			ptItems[nItem].pszName, ptItems[nItem - 1].pszName) == 0))
+		{
+			*pnFailed = nItem;
+			return RLS_PACK_ENAME;
+		}
+		nNames += nLen + 1;
+	}
+	/* at most half full, so probes stay short */
+	while (nBuckets < (uint32_t)nItems * 2)
+		nBuckets <<= 1;
+	nDirSize = sizeof(RLSPackHeader_T) + nItems * sizeof(RLSPackEntry_T)
+			 + nBuckets * sizeof(uint32_t) + nNames;
+	pDir = (uint8_t*)calloc(1, nDirSize);
+	if (!pDir)
+		return RLS_PACK_EMEM;
+	ptEntries = (RLSPackEntry_T*)(pDir + sizeof(RLSPackHeader_T));
+	pnBuckets = (uint32_t*)(ptEntries + nItems);
+	pszNames = (char*)(pnBuckets + nBuckets);
+
+	nOffset = RLS_PACK_ALIGNED(nDirSize);
+	for (nItem = 0; nItem < nItems; nItem++)
+	{
+		RLSPackItem_T* ptItem = &ptItems[nItem];
+		RLSPackEntry_T* ptEntry = &ptEntries[nItem];
+		size_t nLen = strlen(ptItem->pszName);
+		size_t nSize = ptItem->pData ?
+					   RLS_Common_GetSize(ptItem->pData, ptItem->nSize) : 0;
+		int nFrames = 0, nWidth = 0, nHeight = 0;
+		uint32_t nBucket;
+
+		if (!nSize)
+		{
+			nResult = RLS_PACK_EIMAGE;
+			break;
+		}
+		if (nOffset + nSize > UINT32_MAX)
+		{
+			nResult = RLS_PACK_ELARGE;
+			break;
+		}
+		RLS_Common_GetInfo((uint8_t*)ptItem->pData, &nFrames, &nWidth,
+						   &nHeight, NULL);
+		ptItem->nSize = nSize;
+		memcpy(pszNames, ptItem->pszName, nLen + 1);
+		ptEntry->nHash = RLS_Pack_Hash(ptItem->pszName, nLen);
+		ptEntry->nName = (uint32_t)(pszNames - (char*)pDir);
+		ptEntry->nOffset = (uint32_t)nOffset;
+		ptEntry->nSize = (uint32_t)nSize;
+		ptEntry->wWidth = (uint16_t)nWidth;
+		ptEntry->wHeight = (uint16_t)nHeight;
+		ptEntry->wFrames = (uint16_t)nFrames;
+		ptEntry->wNameLen = (uint16_t)nLen;
+		pszNames += nLen + 1;
+		nOffset = RLS_PACK_ALIGNED(nOffset + nSize);
+
+		nBucket = ptEntry->nHash & (nBuckets - 1);
+		while (pnBuckets[nBucket])
+			nBucket = (nBucket + 1) & (nBuckets - 1);
+		pnBuckets[nBucket] = nItem + 1;
+	}
+	if (nResult != RLS_PACK_OK)
+	{
+		*pnFailed = nItem;
+		free(pDir);
+		return nResult;
+	}
+
+	tHeader.nMagic = RLS_PACK_MAGIC;
+	tHeader.wVersion = RLS_PACK_VERSION;
+	tHeader.wReserved = 0;
+	tHeader.nEntries = nItems;
+	tHeader.nBuckets = nBuckets;
+	memcpy(pDir, &tHeader, sizeof(RLSPackHeader_T));
+	if (!RLS_Pack_WriteAll(pOut, pDir, nDirSize))
+		nResult = RLS_PACK_EWRITE;
+	for (nItem = 0; nItem < nItems && nResult == RLS_PACK_OK; nItem++)
+	{
+		if (!RLS_Pack_WriteAll(pOut, ptItems[nItem].pData,
+							   ptItems[nItem].nSize))
+		{
+			*pnFailed = nItem;
+			nResult = RLS_PACK_EWRITE;
+		}
+	}
+	free(pDir);
+	return nResult;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Attach
+**
+** Description:
+**     Opens a pack already in memory, e.g. linked into a firmware image.
+**     The whole directory is checked here, so lookups need no checks.
+**
+** Input:
+**     ptPack - Pack
+**     pData - Pack data, 4-byte aligned, kept until RLS_Pack_Close
+**     nSize - Pack size
+**
+** Output:
+**     Opened pack
+**
+** Return value:
+**     true/false (not a valid pack)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Pack_Attach(RLSPack_T* ptPack, const uint8_t* pData, size_t nSize)
+{
+	const RLSPackHeader_T* ptHeader = (const RLSPackHeader_T*)pData;
+	size_t nDirSize;
+	uint32_t nEntry, nBucket;
+
+	if (!ptPack)
+		return false;
+	memset(ptPack, 0, sizeof(RLSPack_T));
+	if (!pData || nSize < sizeof(RLSPackHeader_T)
+	 || ptHeader->nMagic != RLS_PACK_MAGIC
+	 || ptHeader->wVersion != RLS_PACK_VERSION
+	 || ptHeader->nEntries > INT32_MAX || !ptHeader->nBuckets
+	 || (ptHeader->nBuckets & (ptHeader->nBuckets - 1))
+	 || ptHeader->nBuckets < ptHeader->nEntries)
+		return false;
+	nDirSize = sizeof(RLSPackHeader_T)
+			 + (size_t)ptHeader->nEntries * sizeof(RLSPackEntry_T)
+			 + (size_t)ptHeader->nBuckets * sizeof(uint32_t);
+	if (nDirSize > nSize)
+		return false;
+	ptPack->ptEntries = (const RLSPackEntry_T*)(ptHeader + 1);
+	ptPack->pnBuckets = (const uint32_t*)(ptPack->ptEntries
+										  + ptHeader->nEntries);
+	for (nEntry = 0; nEntry < ptHeader->nEntries; nEntry++)
+	{
+		const RLSPackEntry_T* ptEntry = &ptPack->ptEntries[nEntry];
+		if (ptEntry->nName < nDirSize || ptEntry->nName >= nSize
+		 || ptEntry->wNameLen >= nSize - ptEntry->nName
+		 || pData[ptEntry->nName + ptEntry->wNameLen] != '\0'
+		 || ptEntry->nOffset % RLS_PACK_ALIGN
+		 || ptEntry->nOffset > nSize || ptEntry->nSize > nSize
+		 || ptEntry->nOffset < nDirSize
+		 || ptEntry->nSize > nSize - ptEntry->nOffset)
+			return false;
+	}
+	for (nBucket = 0; nBucket < ptHeader->nBuckets; nBucket++)
+		if (ptPack->pnBuckets[nBucket] > ptHeader->nEntries)
+			return false;
+	ptPack->pData = pData;
+	ptPack->nSize = nSize;
+	ptPack->nEntries = (int)ptHeader->nEntries;
+	ptPack->nMask = ptHeader->nBuckets - 1;
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Open
+**
+** Description:
+**     Maps a pack file and opens it
+**
+** Input:
+**     ptPack - Pack
+**     pszFn - Pack file name
+**
+** Output:
+**     Opened pack
+**
+** Return value:
+**     true/false (missing or not a valid pack)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Pack_Open(RLSPack_T* ptPack, const char* pszFn)
+{
+	RLSFileMap_T tMap;
+	if (!ptPack || !RLS_FileMap_Open(&tMap, pszFn))
+		return false;
+	if (!RLS_Pack_Attach(ptPack, tMap.pData, tMap.nSize))
+	{
+		RLS_FileMap_Close(&tMap);
+		return false;
+	}
+	ptPack->tMap = tMap;
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Close
+**
+** Description:
+**     Closes a pack, unmapping it if RLS_Pack_Open mapped it
+**
+** Input:
+**     ptPack - Pack
+**
+** Output:
+**     Cleared pack
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Pack_Close(RLSPack_T* ptPack)
+{
+	if (!ptPack)
+		return;
+	RLS_FileMap_Close(&ptPack->tMap);
+	memset(ptPack, 0, sizeof(RLSPack_T));
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_Find
+**
+** Description:
+**     Looks an asset up by name through the hash table
+**
+** Input:
+**     ptPack - Pack
+**     pszName - Name
+**
+** Output:
+**     none
+**
+** Return value:
+**     Directory entry/NULL (not in the pack)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+const RLSPackEntry_T* RLS_Pack_Find(const RLSPack_T* ptPack,
+									const char* pszName)
+{
+	size_t nLen;
+	uint32_t nHash, nBucket, nProbes;
+
+	if (!ptPack || !ptPack->pData || !pszName)
+		return NULL;
+	nLen = strlen(pszName);
+	nHash = RLS_Pack_Hash(pszName, nLen);
+	nBucket = nHash & ptPack->nMask;
+	/* a table with no free bucket ends after one round */
+	for (nProbes = 0; nProbes <= ptPack->nMask; nProbes++)
+	{
+		const RLSPackEntry_T* ptEntry;
+		uint32_t nEntry = ptPack->pnBuckets[nBucket];
+		if (!nEntry)
+			break;
+		ptEntry = &ptPack->ptEntries[nEntry - 1];
+		if (ptEntry->nHash == nHash && ptEntry->wNameLen == nLen
+		 && memcmp(ptPack->pData + ptEntry->nName, pszName, nLen) == 0)
+			return ptEntry;
+		nBucket = (nBucket + 1) & ptPack->nMask;
+	}
+	return NULL;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_GetName
+**
+** Description:
+**     Gets the name of a directory entry
+**
+** Input:
+**     ptPack - Pack
+**     ptEntry - Entry (RLS_Pack_Find or ptPack->ptEntries)
+**
+** Output:
+**     none
+**
+** Return value:
+**     Name inside the pack
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+const char* RLS_Pack_GetName(const RLSPack_T* ptPack,
+							 const RLSPackEntry_T* ptEntry)
+{
+	return (const char*)ptPack->pData + ptEntry->nName;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Pack_GetData
+**
+** Description:
+**     Gets the container of a directory entry without copying it, to be
+**     passed to RLS_Decode as is
+**
+** Input:
+**     ptPack - Pack
+**     ptEntry - Entry (RLS_Pack_Find or ptPack->ptEntries)
+**     pnSize - Container size, may be NULL
+**
+** Output:
+**     Container size
+**
+** Return value:
+**     Container inside the pack, read-only
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint8_t* RLS_Pack_GetData(const RLSPack_T* ptPack,
+						  const RLSPackEntry_T* ptEntry, size_t* pnSize)
+{
+	if (pnSize)
+		*pnSize = ptEntry->nSize;
+	/* the decoder takes a non-const pointer but never writes through it */
+	return (uint8_t*)ptPack->pData + ptEntry->nOffset;
+}
\ No newline at end of file
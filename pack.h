@@ -0,0 +1,146 @@
+/*
+** ===========================================================================
+** File: pack.h
+** Description: ReakoLite library resource pack header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_PACK_H
+#define RLS_PACK_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "filemap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+   Pack layout, little-endian:
+   RLSPackHeader_T
+   RLSPackEntry_T * nEntries, sorted by name
+   u32 * nBuckets, hash table: RLS_Pack_Hash(name) & (nBuckets - 1), next
+   bucket on collision; entry + 1, 0 - empty
+   names, NUL terminated
+   containers, each aligned to RLS_PACK_ALIGN from the start of the pack
+*/
+
+#define RLS_PACK_MAGIC 0x4B415052 //stored as 'RPAK'
+#define RLS_PACK_VERSION 1
+#define RLS_PACK_ALIGN 16
+
+#define RLS_PACK_OK 0
+#define RLS_PACK_EMEM 1 /* out of memory */
+#define RLS_PACK_EIMAGE 2 /* not an RLS container */
+#define RLS_PACK_ENAME 3 /* name empty, too long or used twice */
+#define RLS_PACK_ELARGE 4 /* pack would exceed 4 GB */
+#define RLS_PACK_EWRITE 5 /* pack could not be written */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSPackHeader_T RLSPackHeader_T;
+typedef struct tagRLSPackEntry_T RLSPackEntry_T;
+typedef struct tagRLSPackItem_T RLSPackItem_T;
+typedef struct tagRLSPack_T RLSPack_T;
+
+#pragma pack(push)  /* push current alignment to stack */
+#pragma pack(1)     /* set alignment to 1 byte boundary */
+typedef struct tagRLSPackHeader_T
+{
+	uint32_t nMagic;
+	uint16_t wVersion;
+	uint16_t wReserved;
+	uint32_t nEntries;
+	uint32_t nBuckets; /* power of two */
+};
+
+typedef struct tagRLSPackEntry_T
+{
+	uint32_t nHash; /* RLS_Pack_Hash of the name */
+	uint32_t nName; /* name offset from the start of the pack */
+	uint32_t nOffset; /* container offset from the start of the pack */
+	uint32_t nSize; /* container size, frame index included */
+	uint16_t wWidth;
+	uint16_t wHeight;
+	uint16_t wFrames;
+	uint16_t wNameLen; /* without the NUL */
+	uint32_t anReserved[2];
+};
+#pragma pack(pop)   /* restore original alignment from stack */
+
+/* container to pack */
+typedef struct tagRLSPackItem_T
+{
+	const char* pszName;
+	const uint8_t* pData;
+	size_t nSize;
+};
+
+/* opened pack, the directory points into the mapping */
+typedef struct tagRLSPack_T
+{
+	RLSFileMap_T tMap; /* empty if attached to memory */
+	const uint8_t* pData;
+	size_t nSize;
+	const RLSPackEntry_T* ptEntries;
+	const uint32_t* pnBuckets;
+	int nEntries;
+	uint32_t nMask; /* bucket count - 1 */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern uint32_t RLS_Pack_Hash(const char* pszName, size_t nLen);
+extern int RLS_Pack_Write(FILE* pOut, RLSPackItem_T* ptItems, int nItems,
+						  int* pnFailed);
+extern bool RLS_Pack_Attach(RLSPack_T* ptPack, const uint8_t* pData,
+							size_t nSize);
+extern bool RLS_Pack_Open(RLSPack_T* ptPack, const char* pszFn);
+extern void RLS_Pack_Close(RLSPack_T* ptPack);
+extern const RLSPackEntry_T* RLS_Pack_Find(const RLSPack_T* ptPack,
+										   const char* pszName);
+extern const char* RLS_Pack_GetName(const RLSPack_T* ptPack,
+									const RLSPackEntry_T* ptEntry);
+extern uint8_t* RLS_Pack_GetData(const RLSPack_T* ptPack,
+								 const RLSPackEntry_T* ptEntry,
+								 size_t* pnSize);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_PACK_H
\ No newline at end of file
@@ -0,0 +1,638 @@
+/*
+** ===========================================================================
+** File: player.c
+** Description: ReakoLite library prefetching animation player code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decoded frame cache
+** 10/18/2026	agent			Frames drawn over the previous one
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "decode.h"
+#include "player.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_PLAYER_SLOT_EMPTY 0
+#define RLS_PLAYER_SLOT_BUSY 1 /* being decoded */
+#define RLS_PLAYER_SLOT_READY 2
+#define RLS_PLAYER_SLOT_FAILED 3 /* frame could not be decoded */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_Window
+**
+** Description:
+**     Gets how many frames from the current one are decoded ahead
+**
+** Input:
+**     ptPlayer - Player
+**
+** Output:
+**     none
+**
+** Return value:
+**     Window size in frames
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Player_Window(const RLSPlayer_T* ptPlayer)
+{
+	return (ptPlayer->nRing < ptPlayer->nFrames) ? ptPlayer->nRing
+												 : ptPlayer->nFrames;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_InWindow
+**
+** Description:
+**     Checks if a frame is in the decode window
+**
+** Input:
+**     ptPlayer - Player
+**     nFrame - Frame
+**
+** Output:
+**     none
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Player_InWindow(const RLSPlayer_T* ptPlayer, int nFrame)
+{
+	int nAhead = nFrame - ptPlayer->nPlay;
+	if (ptPlayer->bLoop && nAhead < 0)
+		nAhead += ptPlayer->nFrames;
+	return nAhead >= 0 && nAhead < RLS_Player_Window(ptPlayer);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_FindSlot
+**
+** Description:
+**     Finds the ring slot of a frame
+**
+** Input:
+**     ptPlayer - Player
+**     nFrame - Frame
+**
+** Output:
+**     none
+**
+** Return value:
+**     Slot/-1 (not in the ring)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Player_FindSlot(const RLSPlayer_T* ptPlayer, int nFrame)
+{
+	int nSlot;
+	for (nSlot = 0; nSlot < ptPlayer->nRing; nSlot++)
+		if (ptPlayer->anSlotFrame[nSlot] == nFrame)
+			return nSlot;
+	return -1;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_NextJob
+**
+** Description:
+**     Picks the first frame of the window missing from the ring and a slot
+**     for it, one holding no frame of the window
+**
+** Input:
+**     ptPlayer - Player, locked
+**     pnSlot - Slot
+**
+** Output:
+**     Slot
+**
+** Return value:
+**     Frame/-1 (nothing to decode)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Player_NextJob(const RLSPlayer_T* ptPlayer, int* pnSlot)
+{
+	int nAhead, nSlot;
+	for (nAhead = 0; nAhead < RLS_Player_Window(ptPlayer); nAhead++)
+	{
+		int nFrame = ptPlayer->nPlay + nAhead;
+		if (nFrame >= ptPlayer->nFrames)
+		{
+			if (!ptPlayer->bLoop)
+				break;
+			nFrame -= ptPlayer->nFrames;
+		}
+		if (RLS_Player_FindSlot(ptPlayer, nFrame) >= 0)
+			continue;
+		for (nSlot = 0; nSlot < ptPlayer->nRing; nSlot++)
+		{
+			int nHeld = ptPlayer->anSlotFrame[nSlot];
+			if (ptPlayer->abSlotState[nSlot] != RLS_PLAYER_SLOT_BUSY
+			 && (nHeld < 0 || !RLS_Player_InWindow(ptPlayer, nHeld)))
+			{
+				*pnSlot = nSlot;
+				return nFrame;
+			}
+		}
+		break;
+	}
+	return -1;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_Draw
+**
+** Description:
+**     Brings the canvas to a frame. Frames may draw over the one before,
+**     so they are decoded in order from frame 0, which starts on a blank
+**     canvas as in RLS_Export_PNGs; playing on only decodes the next one.
+**
+** Input:
+**     ptPlayer - Player
+**     nFrame - Frame
+**
+** Output:
+**     Frame on the canvas
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_Player_Draw(RLSPlayer_T* ptPlayer, int nFrame)
+{
+	if (ptPlayer->nCanvas < 0 || ptPlayer->nCanvas >= nFrame)
+	{
+		memset(ptPlayer->pCanvas, 0, (size_t)ptPlayer->nWidth
+			   * ptPlayer->nHeight * sizeof(uint16_t));
+		ptPlayer->nCanvas = -1;
+	}
+	while (ptPlayer->nCanvas < nFrame)
+	{
+		if (!RLS_Decode(ptPlayer->pData, ptPlayer->nSize,
+						ptPlayer->nCanvas + 1, ptPlayer->pCanvas,
+						ptPlayer->nWidth))
+		{
+			ptPlayer->nCanvas = -1;
+			return false;
+		}
+		ptPlayer->nCanvas++;
+	}
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_Decoder
+**
+** Description:
+**     Background thread, keeps the decode window in the ring
+**
+** Input:
+**     pArg - Player
+**
+** Output:
+**     Decoded frames in the ring
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decoded frame cache
+** 10/18/2026	agent			Decode in order onto a canvas
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Player_Decoder(void* pArg)
+{
+	RLSPlayer_T* ptPlayer = (RLSPlayer_T*)pArg;
+	size_t nPixels = (size_t)ptPlayer->nWidth * ptPlayer->nHeight;
+
+	RLS_Mutex_Lock(&ptPlayer->tMutex);
+	while (!ptPlayer->bStop)
+	{
+		int nSlot = -1;
+		int nFrame = RLS_Player_NextJob(ptPlayer, &nSlot);
+		bool bOK;
+		if (nFrame < 0)
+		{
+			RLS_Cond_Wait(&ptPlayer->tWork, &ptPlayer->tMutex);
+			continue;
+		}
+		ptPlayer->anSlotFrame[nSlot] = nFrame;
+		ptPlayer->abSlotState[nSlot] = RLS_PLAYER_SLOT_BUSY;
+		/* callers keep reading the other slots meanwhile */
+		RLS_Mutex_Unlock(&ptPlayer->tMutex);
+		if (ptPlayer->ptCache)
+		{
+			const uint16_t* pFrame = RLS_Cache_Decode(ptPlayer->ptCache,
+													  ptPlayer->pData,
+													  ptPlayer->nSize,
+													  nFrame);
+			bOK = pFrame != NULL;
+			if (bOK)
+				memcpy(ptPlayer->pRing + nSlot * nPixels, pFrame,
+					   nPixels * sizeof(uint16_t));
+		}
+		else
+		{
+			/* a slot holds some older frame, the canvas the one before */
+			bOK = RLS_Player_Draw(ptPlayer, nFrame);
+			if (bOK)
+				memcpy(ptPlayer->pRing + nSlot * nPixels, ptPlayer->pCanvas,
+					   nPixels * sizeof(uint16_t));
+		}
+		RLS_Mutex_Lock(&ptPlayer->tMutex);
+		ptPlayer->abSlotState[nSlot] = bOK ? RLS_PLAYER_SLOT_READY
+										   : RLS_PLAYER_SLOT_FAILED;
+		ptPlayer->tStats.nDecoded++;
+		RLS_Cond_Broadcast(&ptPlayer->tReady);
+	}
+	RLS_Mutex_Unlock(&ptPlayer->tMutex);
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_Open
+**
+** Description:
+**     Sets up a player and starts decoding from frame 0
+**
+** Input:
+**     ptPlayer - Player
+**     pData - Container, kept until RLS_Player_Close
+**     nSize - Container size, 0 if unknown
+**     nRing - Frame buffers (0 - RLS_PLAYER_RING)
+**     bLoop - Decode frame 0 ahead after the last frame
+**     nPeriodUs - Frame period for jitter statistics (0 - none)
+**     ptCache - Decoded frame cache, only used by the decoder thread until
+**               RLS_Player_Close (NULL - none)
+**
+** Output:
+**     Running player
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decoded frame cache
+** 10/18/2026	agent			Decode in order onto a canvas
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Player_Open(RLSPlayer_T* ptPlayer, uint8_t* pData, size_t nSize,
+					 int nRing, bool bLoop, uint32_t nPeriodUs,
+					 RLSCache_T* ptCache)
+{
+	int nSlot;
+
+	if (!ptPlayer)
+		return false;
+	memset(ptPlayer, 0, sizeof(RLSPlayer_T));
+	if (!pData || (nSize && nSize < 12))
+		return false;
+	RLS_Common_GetInfo(pData, &ptPlayer->nFrames, &ptPlayer->nWidth,
+					   &ptPlayer->nHeight, NULL);
+	if (ptPlayer->nFrames <= 0 || ptPlayer->nWidth <= 0
+	 || ptPlayer->nHeight <= 0)
+		return false;
+	ptPlayer->pData = pData;
+	ptPlayer->nSize = nSize;
+	ptPlayer->bLoop = bLoop;
+	ptPlayer->nPeriodUs = nPeriodUs;
+	ptPlayer->ptCache = ptCache;
+	ptPlayer->nRing = (nRing > 0) ? nRing : RLS_PLAYER_RING;
+	ptPlayer->pRing = (uint16_t*)malloc((size_t)ptPlayer->nRing
+										* ptPlayer->nWidth
+										* ptPlayer->nHeight
+										* sizeof(uint16_t));
+	ptPlayer->anSlotFrame = (int*)malloc(ptPlayer->nRing * sizeof(int));
+	ptPlayer->abSlotState = (uint8_t*)calloc(ptPlayer->nRing, 1);
+	ptPlayer->pCanvas = (uint16_t*)malloc((size_t)ptPlayer->nWidth
+										  * ptPlayer->nHeight
+										  * sizeof(uint16_t));
+	ptPlayer->nCanvas = -1;
+	if (!ptPlayer->pRing || !ptPlayer->anSlotFrame || !ptPlayer->abSlotState
+	 || !ptPlayer->pCanvas)
+	{
+		free(ptPlayer->pCanvas);
+		free(ptPlayer->abSlotState);
+		free(ptPlayer->anSlotFrame);
+		free(ptPlayer->pRing);
+		return false;
+	}
+	for (nSlot = 0; nSlot < ptPlayer->nRing; nSlot++)
+		ptPlayer->anSlotFrame[nSlot] = -1;
+	if (!RLS_Mutex_Init(&ptPlayer->tMutex))
+	{
+		free(ptPlayer->pCanvas);
+		free(ptPlayer->abSlotState);
+		free(ptPlayer->anSlotFrame);
+		free(ptPlayer->pRing);
+		return false;
+	}
+	if (!RLS_Cond_Init(&ptPlayer->tWork))
+	{
+		RLS_Mutex_Destroy(&ptPlayer->tMutex);
+		free(ptPlayer->pCanvas);
+		free(ptPlayer->abSlotState);
+		free(ptPlayer->anSlotFrame);
+		free(ptPlayer->pRing);
+		return false;
+	}
+	if (!RLS_Cond_Init(&ptPlayer->tReady))
+	{
+		RLS_Cond_Destroy(&ptPlayer->tWork);
+		RLS_Mutex_Destroy(&ptPlayer->tMutex);
+		free(ptPlayer->pCanvas);
+		free(ptPlayer->abSlotState);
+		free(ptPlayer->anSlotFrame);
+		free(ptPlayer->pRing);
+		return false;
+	}
+	if (!RLS_Thread_Create(&ptPlayer->tThread, RLS_Player_Decoder,
+						   ptPlayer))
+	{
+		RLS_Cond_Destroy(&ptPlayer->tReady);
+		RLS_Cond_Destroy(&ptPlayer->tWork);
+		RLS_Mutex_Destroy(&ptPlayer->tMutex);
+		free(ptPlayer->pCanvas);
+		free(ptPlayer->abSlotState);
+		free(ptPlayer->anSlotFrame);
+		free(ptPlayer->pRing);
+		return false;
+	}
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_Close
+**
+** Description:
+**     Stops the decoder thread and frees the player
+**
+** Input:
+**     ptPlayer - Player
+**
+** Output:
+**     Cleared player
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decode in order onto a canvas
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Player_Close(RLSPlayer_T* ptPlayer)
+{
+	if (!ptPlayer || !ptPlayer->pRing)
+		return;
+	RLS_Mutex_Lock(&ptPlayer->tMutex);
+	ptPlayer->bStop = true;
+	RLS_Cond_Signal(&ptPlayer->tWork);
+	RLS_Cond_Broadcast(&ptPlayer->tReady);
+	RLS_Mutex_Unlock(&ptPlayer->tMutex);
+	RLS_Thread_Join(ptPlayer->tThread);
+	RLS_Cond_Destroy(&ptPlayer->tReady);
+	RLS_Cond_Destroy(&ptPlayer->tWork);
+	RLS_Mutex_Destroy(&ptPlayer->tMutex);
+	free(ptPlayer->pCanvas);
+	free(ptPlayer->abSlotState);
+	free(ptPlayer->anSlotFrame);
+	free(ptPlayer->pRing);
+	memset(ptPlayer, 0, sizeof(RLSPlayer_T));
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_GetFrame
+**
+** Description:
+**     Gets a frame and makes it the current one, so decoding goes on
+**     after it. A frame decoded ahead is returned at once; any other
+**     frame (late or seeked to) is waited for or, if bWait is false,
+**     NULL is returned and it is decoded for a later call.
+**
+** Input:
+**     ptPlayer - Player
+**     nFrame - Frame
+**     bWait - Wait for a frame not decoded yet
+**
+** Output:
+**     Statistics
+**
+** Return value:
+**     Frame (width * height RGB565 pixels), valid until the next call/
+**     NULL (not ready yet or failed to decode)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+const uint16_t* RLS_Player_GetFrame(RLSPlayer_T* ptPlayer, int nFrame,
+									bool bWait)
+{
+	RLSPlayerStats_T* ptStats;
+	const uint16_t* pFrame = NULL;
+	uint64_t nNow;
+	int nSlot;
+
+	if (!ptPlayer || !ptPlayer->pRing || nFrame < 0
+	 || nFrame >= ptPlayer->nFrames)
+		return NULL;
+	ptStats = &ptPlayer->tStats;
+	nNow = RLS_Thread_GetTime();
+	RLS_Mutex_Lock(&ptPlayer->tMutex);
+	ptStats->nGets++;
+	if (ptPlayer->nPeriodUs && ptPlayer->nLastGet)
+	{
+		uint64_t nSince = nNow - ptPlayer->nLastGet;
+		uint64_t nJitter = (nSince > ptPlayer->nPeriodUs) ?
+						   nSince - ptPlayer->nPeriodUs :
+						   ptPlayer->nPeriodUs - nSince;
+		ptStats->nJitterUs += nJitter;
+		if (nJitter > ptStats->nMaxJitterUs)
+			ptStats->nMaxJitterUs = nJitter;
+	}
+	ptPlayer->nLastGet = nNow;
+	if (ptPlayer->nPlay != nFrame)
+	{
+		ptPlayer->nPlay = nFrame;
+		RLS_Cond_Signal(&ptPlayer->tWork);
+	}
+
+	nSlot = RLS_Player_FindSlot(ptPlayer, nFrame);
+	if (nSlot >= 0
+	 && ptPlayer->abSlotState[nSlot] != RLS_PLAYER_SLOT_BUSY)
+		ptStats->nReady++;
+	else
+	{
+		ptStats->nLate++;
+		if (!bWait)
+		{
+			RLS_Mutex_Unlock(&ptPlayer->tMutex);
+			return NULL;
+		}
+		while (!ptPlayer->bStop
+			&& ((nSlot = RLS_Player_FindSlot(ptPlayer, nFrame)) < 0
+			 || ptPlayer->abSlotState[nSlot] == RLS_PLAYER_SLOT_BUSY))
+			RLS_Cond_Wait(&ptPlayer->tReady, &ptPlayer->tMutex);
+		nNow = RLS_Thread_GetTime() - nNow;
+		ptStats->nWaitUs += nNow;
+		if (nNow > ptStats->nMaxWaitUs)
+			ptStats->nMaxWaitUs = nNow;
+	}
+	if (nSlot >= 0 && ptPlayer->abSlotState[nSlot] == RLS_PLAYER_SLOT_READY)
+		pFrame = ptPlayer->pRing + (size_t)nSlot * ptPlayer->nWidth
+									 * ptPlayer->nHeight;
+	RLS_Mutex_Unlock(&ptPlayer->tMutex);
+	return pFrame;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Player_GetStats
+**
+** Description:
+**     Gets the statistics of a player
+**
+** Input:
+**     ptPlayer - Player
+**     ptStats - Statistics
+**
+** Output:
+**     Statistics
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Player_GetStats(RLSPlayer_T* ptPlayer, RLSPlayerStats_T* ptStats)
+{
+	if (!ptPlayer || !ptPlayer->pRing || !ptStats)
+		return;
+	RLS_Mutex_Lock(&ptPlayer->tMutex);
+	*ptStats = ptPlayer->tStats;
+	RLS_Mutex_Unlock(&ptPlayer->tMutex);
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*
+** ===========================================================================
+** File: player.h
+** Description: ReakoLite library prefetching animation player header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Decoded frame cache
+** 10/18/2026	agent			Frames drawn over the previous one
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_PLAYER_H
+#define RLS_PLAYER_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "cache.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_PLAYER_RING 4 /* default ring size in frames */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSPlayerStats_T RLSPlayerStats_T;
+typedef struct tagRLSPlayer_T RLSPlayer_T;
+
+typedef struct tagRLSPlayerStats_T
+{
+	uint64_t nGets; /* RLS_Player_GetFrame calls */
+	uint64_t nReady; /* frame was decoded ahead of the call */
+	uint64_t nLate; /* frame was not ready yet */
+	uint64_t nDecoded; /* frames decoded in the background */
+	uint64_t nWaitUs; /* time blocked on late frames */
+	uint64_t nMaxWaitUs;
+	uint64_t nJitterUs; /* summed |call interval - frame period| */
+	uint64_t nMaxJitterUs;
+};
+
+/* plays one container, a thread decodes the frames after the current one
+   into a ring of frame buffers */
+typedef struct tagRLSPlayer_T
+{
+	uint8_t* pData;
+	size_t nSize;
+	int nFrames;
+	int nWidth;
+	int nHeight;
+	bool bLoop; /* frame 0 follows the last frame */
+	uint32_t nPeriodUs; /* frame period, 0 - no jitter statistics */
+	int nRing;
+	uint16_t* pRing; /* nRing frames */
+	int* anSlotFrame; /* frame in each slot, -1 - none */
+	uint8_t* abSlotState; /* RLS_PLAYER_SLOT_* */
+	RLSCache_T* ptCache; /* decoder only, NULL - none */
+	uint16_t* pCanvas; /* decoder only: frames drawn in order */
+	int nCanvas; /* frame on the canvas, -1 - none */
+	int nPlay; /* current frame, the decode window starts here */
+	bool bStop;
+	uint64_t nLastGet; /* time of the last call */
+	RLS_Thread_T tThread;
+	RLS_Mutex_T tMutex;
+	RLS_Cond_T tWork; /* the decoder waits for the window to move */
+	RLS_Cond_T tReady; /* callers wait for late frames */
+	RLSPlayerStats_T tStats;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_Player_Open(RLSPlayer_T* ptPlayer, uint8_t* pData,
+							size_t nSize, int nRing, bool bLoop,
+							uint32_t nPeriodUs, RLSCache_T* ptCache);
+extern void RLS_Player_Close(RLSPlayer_T* ptPlayer);
+extern const uint16_t* RLS_Player_GetFrame(RLSPlayer_T* ptPlayer, int nFrame,
+										   bool bWait);
+extern void RLS_Player_GetStats(RLSPlayer_T* ptPlayer,
+								RLSPlayerStats_T* ptStats);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_PLAYER_H
\ No newline at end of file
@@ -0,0 +1,562 @@
+/*
+** ===========================================================================
+** File: ppng.c
+** Description: ReakoLite library parallel PNG writer
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "ppng.h"
+#include "convert.h"
+#include "thread.h"
+#include "miniz/miniz.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+   The image is cut into horizontal strips, one per thread. Each strip is
+   filtered and deflated on its own; every strip but the last ends with a
+   sync flush (empty stored block), so the raw deflate pieces concatenate
+   into one stream. The zlib header goes in front of the first piece and
+   the Adler-32, combined from the per-strip sums, after the last one.
+*/
+
+#define RLS_PPNG_IDAT_MAX (1024*1024)
+#define RLS_PPNG_ADLER_BASE 65521
+#define RLS_PPNG_FILTERS 5
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSPPNGStrip_T RLSPPNGStrip_T;
+
+typedef struct tagRLSPPNGStrip_T
+{
+	const RLSPPNGInfo_T* ptInfo;
+	int nFirstRow;
+	int nRows;
+	bool bLast;
+	bool bOK;
+	uint8_t* pOut; /* deflate data */
+	size_t nOutSize;
+	size_t nOutCap;
+	uint32_t dwAdler; /* of the filtered rows */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static const uint8_t RLS_PPNG_Sig[8] =
+{
+	0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_PutBuf
+**
+** Description:
+**     Appends data to a strip's output buffer (tdefl output callback)
+**
+** Input:
+**     pBuf - Data
+**     nLen - Data size
+**     pUser - Strip
+**
+** Output:
+**     Strip output
+**
+** Return value:
+**     MZ_TRUE/MZ_FALSE
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static mz_bool RLS_PPNG_PutBuf(const void* pBuf, int nLen, void* pUser)
+{
+	RLSPPNGStrip_T* ptStrip = (RLSPPNGStrip_T*)pUser;
+	if (ptStrip->nOutSize + nLen > ptStrip->nOutCap)
+	{
+		size_t nCap = ptStrip->nOutCap ? ptStrip->nOutCap * 2 : 64 * 1024;
+		uint8_t* pOut;
+		while (nCap < ptStrip->nOutSize + nLen)
+			nCap *= 2;
+		pOut = (uint8_t*)realloc(ptStrip->pOut, nCap);
+		if (!pOut)
+			return MZ_FALSE;
+		ptStrip->pOut = pOut;
+		ptStrip->nOutCap = nCap;
+	}
+	memcpy(ptStrip->pOut + ptStrip->nOutSize, pBuf, nLen);
+	ptStrip->nOutSize += nLen;
+	return MZ_TRUE;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_Filter
+**
+** Description:
+**     Filters a row with every allowed filter and keeps the one with the
+**     smallest sum of absolute (signed) bytes, like libpng and spng
+**
+** Input:
+**     pCur - Unfiltered row
+**     pPrev - Unfiltered previous row (zeroes for the first row)
+**     nSize - Row size
+**     nBpp - Filter distance
+**     nFilters - RLS_PNGF_* combination
+**     apCand - RLS_PPNG_FILTERS buffers of nSize + 1 bytes
+**
+** Output:
+**     Candidate rows
+**
+** Return value:
+**     Filtered row, filter type byte first
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint8_t* RLS_PPNG_Filter(const uint8_t* pCur, const uint8_t* pPrev,
+								size_t nSize, int nBpp, int nFilters,
+								uint8_t** apCand)
+{
+	uint8_t* pBest = NULL;
+	uint64_t qwBestSum = 0;
+	int nFilter;
+
+	for (nFilter = 0; nFilter < RLS_PPNG_FILTERS; nFilter++)
+	{
+		uint8_t* pOut = apCand[nFilter];
+		uint64_t qwSum = 0;
+		size_t nIdx;
+		if (!(nFilters & (RLS_PNGF_NONE << nFilter)))
+			continue;
+		pOut[0] = (uint8_t)nFilter;
+		for (nIdx = 0; nIdx < nSize; nIdx++)
+		{
+			int nA = nIdx >= (size_t)nBpp ? pCur[nIdx - nBpp] : 0;
+			int nB = pPrev[nIdx];
+			int nC = nIdx >= (size_t)nBpp ? pPrev[nIdx - nBpp] : 0;
+			int nPred = 0;
+			uint8_t bOut;
+			switch (nFilter)
+			{
+			case 1:
+				nPred = nA;
+				break;
+			case 2:
+				nPred = nB;
+				break;
+			case 3:
+				nPred = (nA + nB) >> 1;
+				break;
+			case 4:
+			{
+				int nP = nA + nB - nC;
+				int nPA = abs(nP - nA), nPB = abs(nP - nB);
+				int nPC = abs(nP - nC);
+				nPred = (nPA <= nPB && nPA <= nPC) ? nA
+					  : (nPB <= nPC) ? nB : nC;
+				break;
+			}
+			}
+			bOut = (uint8_t)(pCur[nIdx] - nPred);
+			pOut[nIdx + 1] = bOut;
+			qwSum += bOut < 128 ? bOut : 256 - bOut;
+		}
+		if (!pBest || qwSum < qwBestSum)
+		{
+			pBest = pOut;
+			qwBestSum = qwSum;
+		}
+	}
+	return pBest;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_Strip
+**
+** Description:
+**     Filters and deflates one strip of rows (thread function)
+**
+** Input:
+**     pArg - Strip
+**
+** Output:
+**     Strip deflate data and Adler-32
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_PPNG_Strip(void* pArg)
+{
+	RLSPPNGStrip_T* ptStrip = (RLSPPNGStrip_T*)pArg;
+	const RLSPPNGInfo_T* ptInfo = ptStrip->ptInfo;
+	size_t nRowSize = ptInfo->nRowSize;
+	tdefl_compressor* ptDefl;
+	uint8_t* pBuff;
+	uint8_t* pPrev;
+	uint8_t* pCur;
+	uint8_t* apCand[RLS_PPNG_FILTERS];
+	int nRow, nFilter;
+	bool bOK = true;
+
+	ptDefl = (tdefl_compressor*)malloc(sizeof(tdefl_compressor));
+	pBuff = (uint8_t*)malloc(2 * nRowSize
+						   + RLS_PPNG_FILTERS * (nRowSize + 1));
+	if (!ptDefl || !pBuff)
+	{
+		free(ptDefl);
+		free(pBuff);
+		return;
+	}
+	pPrev = pBuff;
+	pCur = pBuff + nRowSize;
+	for (nFilter = 0; nFilter < RLS_PPNG_FILTERS; nFilter++)
+		apCand[nFilter] = pBuff + 2 * nRowSize + nFilter * (nRowSize + 1);
+
+	/* negative window bits: raw deflate, the caller frames the stream */
+	tdefl_init(ptDefl, RLS_PPNG_PutBuf, ptStrip,
+			   tdefl_create_comp_flags_from_zip_params(ptInfo->nLevel, -15,
+			   ptInfo->nFilters == RLS_PNGF_NONE ? MZ_DEFAULT_STRATEGY
+												 : MZ_FILTERED));
+	if (ptStrip->nFirstRow > 0)
+		ptInfo->pfnRow(ptInfo->pRowArg, ptStrip->nFirstRow - 1, pPrev);
+	else
+		memset(pPrev, 0, nRowSize);
+
+	ptStrip->dwAdler = 1;
+	for (nRow = 0; nRow < ptStrip->nRows && bOK; nRow++)
+	{
+		uint8_t* pFiltered;
+		uint8_t* pSwap;
+		ptInfo->pfnRow(ptInfo->pRowArg, ptStrip->nFirstRow + nRow, pCur);
+		pFiltered = RLS_PPNG_Filter(pCur, pPrev, nRowSize,
+									ptInfo->nPixelBytes, ptInfo->nFilters,
+									apCand);
+		ptStrip->dwAdler = (uint32_t)mz_adler32(ptStrip->dwAdler, pFiltered,
+												nRowSize + 1);
+		bOK = tdefl_compress_buffer(ptDefl, pFiltered, nRowSize + 1,
+									TDEFL_NO_FLUSH) == TDEFL_STATUS_OKAY;
+		pSwap = pPrev;
+		pPrev = pCur;
+		pCur = pSwap;
+	}
+	if (bOK)
+	{
+		if (ptStrip->bLast)
+			bOK = tdefl_compress_buffer(ptDefl, NULL, 0, TDEFL_FINISH)
+				== TDEFL_STATUS_DONE;
+		else
+			bOK = tdefl_compress_buffer(ptDefl, NULL, 0, TDEFL_SYNC_FLUSH)
+				== TDEFL_STATUS_OKAY;
+	}
+	ptStrip->bOK = bOK;
+	free(ptDefl);
+	free(pBuff);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_AdlerCombine
+**
+** Description:
+**     Adler-32 of two concatenated buffers from their own sums
+**
+** Input:
+**     dwAdler1 - Adler-32 of the first buffer
+**     dwAdler2 - Adler-32 of the second buffer
+**     nLen2 - Size of the second buffer
+**
+** Output:
+**     none
+**
+** Return value:
+**     Combined Adler-32
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint32_t RLS_PPNG_AdlerCombine(uint32_t dwAdler1, uint32_t dwAdler2,
+									  uint64_t nLen2)
+{
+	uint32_t dwRem = (uint32_t)(nLen2 % RLS_PPNG_ADLER_BASE);
+	uint32_t dwSum1 = dwAdler1 & 0xFFFF;
+	uint32_t dwSum2 = (uint32_t)(((uint64_t)dwRem * dwSum1)
+								% RLS_PPNG_ADLER_BASE);
+	dwSum1 += (dwAdler2 & 0xFFFF) + RLS_PPNG_ADLER_BASE - 1;
+	dwSum2 += (dwAdler1 >> 16) + (dwAdler2 >> 16)
+			+ RLS_PPNG_ADLER_BASE - dwRem;
+	if (dwSum1 >= RLS_PPNG_ADLER_BASE)
+		dwSum1 -= RLS_PPNG_ADLER_BASE;
+	if (dwSum1 >= RLS_PPNG_ADLER_BASE)
+		dwSum1 -= RLS_PPNG_ADLER_BASE;
+	if (dwSum2 >= 2 * RLS_PPNG_ADLER_BASE)
+		dwSum2 -= 2 * RLS_PPNG_ADLER_BASE;
+	if (dwSum2 >= RLS_PPNG_ADLER_BASE)
+		dwSum2 -= RLS_PPNG_ADLER_BASE;
+	return dwSum1 | (dwSum2 << 16);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_Put32
+**
+** Description:
+**     Stores a big endian 32-bit value
+**
+** Input:
+**     pOut - Destination
+**     dwValue - Value
+**
+** Output:
+**     Stored value
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_PPNG_Put32(uint8_t* pOut, uint32_t dwValue)
+{
+	pOut[0] = (uint8_t)(dwValue >> 24);
+	pOut[1] = (uint8_t)(dwValue >> 16);
+	pOut[2] = (uint8_t)(dwValue >> 8);
+	pOut[3] = (uint8_t)dwValue;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_WriteChunk
+**
+** Description:
+**     Writes a PNG chunk
+**
+** Input:
+**     pFile - Output file
+**     pszType - Chunk type (4 characters)
+**     pData - Chunk data
+**     nSize - Chunk data size
+**
+** Output:
+**     Chunk in file
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_PPNG_WriteChunk(FILE* pFile, const char* pszType,
+								const uint8_t* pData, size_t nSize)
+{
+	uint8_t abHead[8], abCRC[4];
+	mz_ulong dwCRC;
+	RLS_PPNG_Put32(abHead, (uint32_t)nSize);
+	memcpy(abHead + 4, pszType, 4);
+	dwCRC = mz_crc32(MZ_CRC32_INIT, abHead + 4, 4);
+	if (nSize)
+		dwCRC = mz_crc32(dwCRC, pData, nSize);
+	RLS_PPNG_Put32(abCRC, (uint32_t)dwCRC);
+	return fwrite(abHead, 1, 8, pFile) == 8
+		&& (!nSize || fwrite(pData, 1, nSize, pFile) == nSize)
+		&& fwrite(abCRC, 1, 4, pFile) == 4;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PPNG_Write
+**
+** Description:
+**     Writes a PNG, filtering and deflating horizontal strips of the image
+**     on separate threads
+**
+** Input:
+**     pFile - Output file
+**     ptInfo - Image information and row source
+**     nThreads - Thread count (strips are never smaller than
+**                RLS_PPNG_MIN_STRIP raw bytes, so small images use fewer)
+**
+** Output:
+**     PNG file
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_PPNG_Write(FILE* pFile, const RLSPPNGInfo_T* ptInfo, int nThreads)
+{
+	RLSPPNGStrip_T atStrips[RLS_THREAD_MAX];
+	uint64_t qwRawSize;
+	uint32_t dwAdler = 1;
+	uint8_t abIHDR[13], abTail[4];
+	uint8_t abZHead[2] = { 0x78, 0 };
+	int nStrips, nStrip, nStripRows;
+	bool bOK = true;
+
+	if (!pFile || !ptInfo || !ptInfo->pfnRow || ptInfo->nWidth <= 0
+	 || ptInfo->nHeight <= 0 || ptInfo->nRowSize == 0
+	 || ptInfo->nPixelBytes <= 0 || !(ptInfo->nFilters & RLS_PNGF_ALL))
+		return false;
+
+	qwRawSize = (uint64_t)ptInfo->nHeight * (ptInfo->nRowSize + 1);
+	nStrips = (int)(qwRawSize / RLS_PPNG_MIN_STRIP);
+	if (nStrips > nThreads)
+		nStrips = nThreads;
+	if (nStrips > RLS_THREAD_MAX)
+		nStrips = RLS_THREAD_MAX;
+	if (nStrips > ptInfo->nHeight)
+		nStrips = ptInfo->nHeight;
+	if (nStrips < 1)
+		nStrips = 1;
+	nStripRows = (ptInfo->nHeight + nStrips - 1) / nStrips;
+	nStrips = (ptInfo->nHeight + nStripRows - 1) / nStripRows;
+
+	memset(atStrips, 0, sizeof(atStrips));
+	for (nStrip = 0; nStrip < nStrips; nStrip++)
+	{
+		atStrips[nStrip].ptInfo = ptInfo;
+		atStrips[nStrip].nFirstRow = nStrip * nStripRows;
+		atStrips[nStrip].nRows = nStripRows;
+		if (nStrip == nStrips - 1)
+		{
+			atStrips[nStrip].nRows = ptInfo->nHeight - nStrip * nStripRows;
+			atStrips[nStrip].bLast = true;
+		}
+	}
+	/* zlib header: 32K window, FLEVEL from the level, FCHECK */
+	abZHead[1] = (uint8_t)((ptInfo->nLevel < 2 ? 0 : ptInfo->nLevel < 6 ? 1
+						  : ptInfo->nLevel == 6 ? 2 : 3) << 6);
+	abZHead[1] += (uint8_t)(31 - (abZHead[0] * 256 + abZHead[1]) % 31);
+	if (!RLS_PPNG_PutBuf(abZHead, 2, &atStrips[0]))
+		return false;
+
+	RLS_Thread_Run(RLS_PPNG_Strip, atStrips, sizeof(RLSPPNGStrip_T),
+				   nStrips);
+
+	for (nStrip = 0; nStrip < nStrips; nStrip++)
+	{
+		bOK = bOK && atStrips[nStrip].bOK;
+		dwAdler = RLS_PPNG_AdlerCombine(dwAdler, atStrips[nStrip].dwAdler,
+						(uint64_t)atStrips[nStrip].nRows
+					  * (ptInfo->nRowSize + 1));
+	}
+	RLS_PPNG_Put32(abTail, dwAdler);
+	bOK = bOK && RLS_PPNG_PutBuf(abTail, 4, &atStrips[nStrips - 1]);
+
+	RLS_PPNG_Put32(abIHDR, ptInfo->nWidth);
+	RLS_PPNG_Put32(abIHDR + 4, ptInfo->nHeight);
+	abIHDR[8] = (uint8_t)ptInfo->nBitDepth;
+	abIHDR[9] = (uint8_t)ptInfo->nColorType;
+	abIHDR[10] = abIHDR[11] = abIHDR[12] = 0;
+	bOK = bOK && fwrite(RLS_PPNG_Sig, 1, 8, pFile) == 8
+		&& RLS_PPNG_WriteChunk(pFile, "IHDR", abIHDR, 13);
+	if (ptInfo->nColorType == RLS_PPNG_CT_INDEXED)
+		bOK = bOK && RLS_PPNG_WriteChunk(pFile, "PLTE", ptInfo->pPLTE,
+										 ptInfo->nPLTECols * 3);
+	for (nStrip = 0; nStrip < nStrips; nStrip++)
+	{
+		size_t nPos;
+		for (nPos = 0; bOK && nPos < atStrips[nStrip].nOutSize;
+			 nPos += RLS_PPNG_IDAT_MAX)
+		{
+			size_t nSize = atStrips[nStrip].nOutSize - nPos;
+			if (nSize > RLS_PPNG_IDAT_MAX)
+				nSize = RLS_PPNG_IDAT_MAX;
+			bOK = RLS_PPNG_WriteChunk(pFile, "IDAT",
+									  atStrips[nStrip].pOut + nPos, nSize);
+		}
+		free(atStrips[nStrip].pOut);
+	}
+	return bOK && RLS_PPNG_WriteChunk(pFile, "IEND", NULL, 0);
+}
\ No newline at end of file
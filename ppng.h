@@ -0,0 +1,88 @@
+/*
+** ===========================================================================
+** File: ppng.h
+** Description: ReakoLite library parallel PNG writer header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_PPNG_H
+#define RLS_PPNG_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_PPNG_CT_INDEXED 3
+#define RLS_PPNG_CT_TRUECOLOR 2
+
+#define RLS_PPNG_MIN_STRIP (256*1024) /* raw bytes worth a thread */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/* Fills pRow with the unfiltered bytes of image row nRow, may be called
+   from several threads at once */
+typedef void (*RLS_PPNG_RowFn_T)(void* pArg, int nRow, uint8_t* pRow);
+
+typedef struct tagRLSPPNGInfo_T RLSPPNGInfo_T;
+
+typedef struct tagRLSPPNGInfo_T
+{
+	int nWidth;
+	int nHeight;
+	int nBitDepth;
+	int nColorType; /* RLS_PPNG_CT_* */
+	int nPixelBytes; /* filter distance, at least 1 */
+	size_t nRowSize; /* unfiltered row bytes */
+	const uint8_t* pPLTE; /* RGB triplets for indexed images */
+	int nPLTECols;
+	int nLevel; /* deflate level 0 - 9 */
+	int nFilters; /* RLS_PNGF_* combination */
+	RLS_PPNG_RowFn_T pfnRow;
+	void* pRowArg;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_PPNG_Write(FILE* pFile, const RLSPPNGInfo_T* ptInfo,
+						   int nThreads);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_PPNG_H
\ No newline at end of file
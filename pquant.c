@@ -0,0 +1,622 @@
+/*
+** ===========================================================================
+** File: pquant.c
+** Description: ReakoLite library palette quantizer (median cut + k-means)
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Median cut split fix
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "quant.h"
+#include "thread.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef RLS_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_PQUANT_COLORS (UINT16_MAX + 1)
+#define RLS_PQUANT_KMEANS 4 /* k-means refinement passes */
+#define RLS_PQUANT_MT_MIN 4096 /* distinct colors per search thread */
+
+#define RLS_PQUANT_R(c) ((c) >> 11)
+#define RLS_PQUANT_G(c) (((c) >> 5) & 0x3f)
+#define RLS_PQUANT_B(c) ((c) & 0x1f)
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSPQuantBox_T RLSPQuantBox_T;
+typedef struct tagRLSPQuantSearch_T RLSPQuantSearch_T;
+
+typedef struct tagRLSPQuantBox_T
+{
+	int nFirst;
+	int nCount;
+	uint32_t nPixels;
+	int nChan;
+	int nRange;
+};
+
+typedef struct tagRLSPQuantSearch_T
+{
+	const uint16_t* pCols;
+	int nCols;
+	const int16_t* pPalR;
+	const int16_t* pPalG;
+	const int16_t* pPalB;
+	int nPalCols;
+	uint8_t* pMap;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_GetChan
+**
+** Description:
+**     Gets a channel of an RGB565 color in 8-bit scale
+**
+** Input:
+**     wColor - RGB565 color
+**     nChan - channel (0 - red, 1 - green, 2 - blue)
+**
+** Output:
+**     none
+**
+** Return value:
+**     0..255
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_PQuant_GetChan(uint16_t wColor, int nChan)
+{
+	if (nChan == 0)
+		return RLS_PQUANT_R(wColor) << 3;
+	if (nChan == 1)
+		return RLS_PQUANT_G(wColor) << 2;
+	return RLS_PQUANT_B(wColor) << 3;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_ShrinkBox
+**
+** Description:
+**     Computes pixel count and widest channel of a box
+**
+** Input:
+**     ptBox - box
+**     pCols - distinct colors
+**     pHist - color histogram
+**
+** Output:
+**     Updated box
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_PQuant_ShrinkBox(RLSPQuantBox_T* ptBox, const uint16_t* pCols,
+								 const uint32_t* pHist)
+{
+	int anMin[3] = { 255, 255, 255 };
+	int anMax[3] = { 0, 0, 0 };
+	int nCol, nChan;
+
+	ptBox->nPixels = 0;
+	for (nCol = ptBox->nFirst; nCol < ptBox->nFirst + ptBox->nCount; nCol++)
+	{
+		ptBox->nPixels += pHist[pCols[nCol]];
+		for (nChan = 0; nChan < 3; nChan++)
+		{
+			int nVal = RLS_PQuant_GetChan(pCols[nCol], nChan);
+			if (nVal < anMin[nChan])
+				anMin[nChan] = nVal;
+			if (nVal > anMax[nChan])
+				anMax[nChan] = nVal;
+		}
+	}
+	ptBox->nChan = 0;
+	ptBox->nRange = anMax[0] - anMin[0];
+	for (nChan = 1; nChan < 3; nChan++)
+	{
+		if (anMax[nChan] - anMin[nChan] > ptBox->nRange)
+		{
+			ptBox->nChan = nChan;
+			ptBox->nRange = anMax[nChan] - anMin[nChan];
+		}
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_SplitBox
+**
+** Description:
+**     Sorts a box along its widest channel (counting sort) and splits it at
+**     the pixel-weighted median
+**
+** Input:
+**     ptBox - box to split
+**     ptNew - new box
+**     pCols - distinct colors
+**     pHist - color histogram
+**     pTmp - scratch, at least ptBox->nCount colors
+**
+** Output:
+**     Two boxes
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Never leave the new box empty
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static bool RLS_PQuant_SplitBox(RLSPQuantBox_T* ptBox, RLSPQuantBox_T* ptNew,
+								uint16_t* pCols, const uint32_t* pHist,
+								uint16_t* pTmp)
+{
+	int anPos[256 + 1];
+	uint16_t* pBoxCols = pCols + ptBox->nFirst;
+	uint32_t nHalf, nSum = 0;
+	int nCol, nSplit;
+
+	if (ptBox->nCount < 2)
+		return false;
+	memset(anPos, 0, sizeof(anPos));
+	for (nCol = 0; nCol < ptBox->nCount; nCol++)
+		anPos[RLS_PQuant_GetChan(pBoxCols[nCol], ptBox->nChan) + 1]++;
+	for (nCol = 1; nCol <= 256; nCol++)
+		anPos[nCol] += anPos[nCol - 1];
+	for (nCol = 0; nCol < ptBox->nCount; nCol++)
+		pTmp[anPos[RLS_PQuant_GetChan(pBoxCols[nCol], ptBox->nChan)]++]
+			= pBoxCols[nCol];
+	memcpy(pBoxCols, pTmp, ptBox->nCount * sizeof(uint16_t));
+
+	/* the upper box keeps at least one color */
+	nHalf = ptBox->nPixels / 2;
+	for (nSplit = 0; nSplit < ptBox->nCount - 2; nSplit++)
+	{
+		nSum += pHist[pBoxCols[nSplit]];
+		if (nSum >= nHalf)
+			break;
+	}
+	nSplit++; /* first color of the upper box */
+
+	ptNew->nFirst = ptBox->nFirst + nSplit;
+	ptNew->nCount = ptBox->nCount - nSplit;
+	ptBox->nCount = nSplit;
+	RLS_PQuant_ShrinkBox(ptBox, pCols, pHist);
+	RLS_PQuant_ShrinkBox(ptNew, pCols, pHist);
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_SearchBest
+**
+** Description:
+**     Finds the nearest palette entry of an RGB565 color. Distance is
+**     squared error in 8-bit scale divided by 16, so it fits in 16 bits.
+**
+** Input:
+**     wColor - RGB565 color
+**     ptSearch - search parameters (palette padded to 8 entries)
+**
+** Output:
+**     none
+**
+** Return value:
+**     Palette index
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static uint8_t RLS_PQuant_SearchBest(uint16_t wColor,
+									 const RLSPQuantSearch_T* ptSearch)
+{
+	int nR = RLS_PQUANT_R(wColor);
+	int nG = RLS_PQUANT_G(wColor);
+	int nB = RLS_PQUANT_B(wColor);
+	int nIdx, nBest = 0, nBestDist = INT16_MAX;
+#ifdef RLS_HAVE_SSE2
+	int16_t anDist[8], anIdx[8];
+	__m128i vR = _mm_set1_epi16((int16_t)nR);
+	__m128i vG = _mm_set1_epi16((int16_t)nG);
+	__m128i vB = _mm_set1_epi16((int16_t)nB);
+	__m128i vBest = _mm_set1_epi16(INT16_MAX);
+	__m128i vBestIdx = _mm_setzero_si128();
+	__m128i vIdx = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+	__m128i vStep = _mm_set1_epi16(8);
+
+	for (nIdx = 0; nIdx < ptSearch->nPalCols; nIdx += 8)
+	{
+		__m128i vDR = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)
+										(ptSearch->pPalR + nIdx)), vR);
+		__m128i vDG = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)
+										(ptSearch->pPalG + nIdx)), vG);
+		__m128i vDB = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)
+										(ptSearch->pPalB + nIdx)), vB);
+		__m128i vDist = _mm_add_epi16(
+			_mm_slli_epi16(_mm_add_epi16(_mm_mullo_epi16(vDR, vDR),
+										 _mm_mullo_epi16(vDB, vDB)), 2),
+			_mm_mullo_epi16(vDG, vDG));
+		__m128i vLess = _mm_cmplt_epi16(vDist, vBest);
+		vBest = _mm_min_epi16(vDist, vBest);
+		vBestIdx = _mm_or_si128(_mm_and_si128(vLess, vIdx),
+								_mm_andnot_si128(vLess, vBestIdx));
+		vIdx = _mm_add_epi16(vIdx, vStep);
+	}
+	_mm_storeu_si128((__m128i*)anDist, vBest);
+	_mm_storeu_si128((__m128i*)anIdx, vBestIdx);
+	for (nIdx = 0; nIdx < 8; nIdx++)
+	{
+		if (anDist[nIdx] < nBestDist
+		|| (anDist[nIdx] == nBestDist && anIdx[nIdx] < nBest))
+		{
+			nBestDist = anDist[nIdx];
+			nBest = anIdx[nIdx];
+		}
+	}
+#else
+	for (nIdx = 0; nIdx < ptSearch->nPalCols; nIdx++)
+	{
+		int nDR = ptSearch->pPalR[nIdx] - nR;
+		int nDG = ptSearch->pPalG[nIdx] - nG;
+		int nDB = ptSearch->pPalB[nIdx] - nB;
+		int nDist = ((nDR * nDR + nDB * nDB) << 2) + nDG * nDG;
+		if (nDist < nBestDist)
+		{
+			nBestDist = nDist;
+			nBest = nIdx;
+		}
+	}
+#endif
+	return (uint8_t)nBest;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_SearchThread
+**
+** Description:
+**     Maps a range of distinct colors to nearest palette entries
+**
+** Input:
+**     pArg - search parameters
+**
+** Output:
+**     Filled map
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_PQuant_SearchThread(void* pArg)
+{
+	RLSPQuantSearch_T* ptSearch = (RLSPQuantSearch_T*)pArg;
+	int nCol;
+	for (nCol = 0; nCol < ptSearch->nCols; nCol++)
+		ptSearch->pMap[ptSearch->pCols[nCol]]
+			= RLS_PQuant_SearchBest(ptSearch->pCols[nCol], ptSearch);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_PQuant_MapColors
+**
+** Description:
+**     Maps distinct colors to nearest palette entries, split over threads
+**
+** Input:
+**     pCols - distinct colors
+**     nCols - distinct color count
+**     pPal - palette
+**     nPalCols - palette size
+**     pMap - color to palette index map (RLS_PQUANT_COLORS entries)
+**
+** Output:
+**     Filled map
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_PQuant_MapColors(const uint16_t* pCols, int nCols,
+								 const uint16_t* pPal, int nPalCols,
+								 uint8_t* pMap)
+{
+	RLSPQuantSearch_T atSearch[RLS_THREAD_MAX];
+	int16_t anPalR[RLS_SPAL_SIZE], anPalG[RLS_SPAL_SIZE];
+	int16_t anPalB[RLS_SPAL_SIZE];
+	int nThreads = RLS_Thread_GetCPUs();
+	int nPadCols = (nPalCols + 7) & ~7;
+	int nIdx, nPer;
+
+	/* pad with copies of entry 0, ties resolve to the lowest index */
+	for (nIdx = 0; nIdx < nPadCols; nIdx++)
+	{
+		uint16_t wColor = pPal[(nIdx < nPalCols) ? nIdx : 0];
+		anPalR[nIdx] = RLS_PQUANT_R(wColor);
+		anPalG[nIdx] = RLS_PQUANT_G(wColor);
+		anPalB[nIdx] = RLS_PQUANT_B(wColor);
+	}
+	if (nThreads > nCols / RLS_PQUANT_MT_MIN)
+		nThreads = nCols / RLS_PQUANT_MT_MIN;
+	if (nThreads < 1)
+		nThreads = 1;
+	nPer = RLS_CEIL(nCols, nThreads);
+	for (nIdx = 0; nIdx < nThreads; nIdx++)
+	{
+		atSearch[nIdx].pCols = pCols + nIdx * nPer;
+		atSearch[nIdx].nCols = (nIdx == nThreads - 1)
+							 ? nCols - nIdx * nPer : nPer;
+		atSearch[nIdx].pPalR = anPalR;
+		atSearch[nIdx].pPalG = anPalG;
+		atSearch[nIdx].pPalB = anPalB;
+		atSearch[nIdx].nPalCols = nPadCols;
+		atSearch[nIdx].pMap = pMap;
+	}
+	RLS_Thread_Run(RLS_PQuant_SearchThread, atSearch,
+				   sizeof(RLSPQuantSearch_T), nThreads);
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quantize_Palette
+**
+** Description:
+**     Reduces an image to at most nMaxCols colors (median cut, refined with
+**     k-means), so every pixel can be stored in the standard palette.
+**     Images already within the limit are left untouched.
+**
+** Input:
+**     pImg - Image to quantize
+**     nWidth - Width of image
+**     nHeight - Height of image
+**     nStride - Row stride of image in pixels
+**     pPal - Resulting palette (at least nMaxCols entries)
+**     nMaxCols - Maximum color count (1..RLS_SPAL_SIZE)
+**
+** Output:
+**     Quantized image, palette
+**
+** Return value:
+**     Palette size/0
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Quantize_Palette(RGB565_T* pImg, int nWidth, int nHeight,
+						 int nStride, uint16_t* pPal, int nMaxCols)
+{
+	RLSPQuantBox_T atBoxes[RLS_SPAL_SIZE];
+	uint32_t* pHist;
+	uint16_t* pCols;
+	uint16_t* pTmp;
+	uint8_t* pMap;
+	RGB565_T* pRow;
+	int nCols = 0, nBoxes = 1;
+	int nPix, nCol, nBox, nPass, nY;
+
+	if (!pImg || !pPal || nWidth <= 0 || nHeight <= 0 || nStride < nWidth
+	 || nMaxCols <= 0)
+		return 0;
+	if (nMaxCols > RLS_SPAL_SIZE)
+		nMaxCols = RLS_SPAL_SIZE;
+
+	pHist = (uint32_t*)calloc(RLS_PQUANT_COLORS, sizeof(uint32_t));
+	pCols = (uint16_t*)malloc(2 * RLS_PQUANT_COLORS * sizeof(uint16_t));
+	pMap = (uint8_t*)malloc(RLS_PQUANT_COLORS);
+	if (!pHist || !pCols || !pMap)
+	{
+		free(pHist);
+		free(pCols);
+		free(pMap);
+		return 0;
+	}
+	pTmp = pCols + RLS_PQUANT_COLORS;
+
+	for (nY = 0, pRow = pImg; nY < nHeight; nY++, pRow += nStride)
+		for (nPix = 0; nPix < nWidth; nPix++)
+			pHist[pRow[nPix]]++;
+	for (nCol = 0; nCol < RLS_PQUANT_COLORS; nCol++)
+		if (pHist[nCol])
+			pCols[nCols++] = (uint16_t)nCol;
+
+	if (nCols <= nMaxCols) /* fits already, keep it lossless */
+	{
+		memcpy(pPal, pCols, nCols * sizeof(uint16_t));
+		free(pHist);
+		free(pCols);
+		free(pMap);
+		return nCols;
+	}
+
+	/* median cut: split the widest box with most pixels */
+	atBoxes[0].nFirst = 0;
+	atBoxes[0].nCount = nCols;
+	RLS_PQuant_ShrinkBox(&atBoxes[0], pCols, pHist);
+	while (nBoxes < nMaxCols)
+	{
+		int nSplit = -1;
+		uint64_t nBestScore = 0;
+		for (nBox = 0; nBox < nBoxes; nBox++)
+		{
+			uint64_t nScore = (uint64_t)atBoxes[nBox].nRange
+							* atBoxes[nBox].nPixels;
+			if (atBoxes[nBox].nCount > 1 && nScore >= nBestScore)
+			{
+				nBestScore = nScore;
+				nSplit = nBox;
+			}
+		}
+		if (nSplit < 0 || RLS_PQuant_SplitBox(&atBoxes[nSplit],
+			&atBoxes[nBoxes], pCols, pHist, pTmp) == false)
+			break;
+		nBoxes++;
+	}
+
+	/* initial palette: pixel-weighted box averages */
+	for (nBox = 0; nBox < nBoxes; nBox++)
+	{
+		uint64_t anSum[3] = { 0, 0, 0 };
+		uint32_t nPixels = 0;
+		for (nCol = atBoxes[nBox].nFirst;
+			 nCol < atBoxes[nBox].nFirst + atBoxes[nBox].nCount; nCol++)
+		{
+			uint32_t nCount = pHist[pCols[nCol]];
+			anSum[0] += (uint64_t)RLS_PQUANT_R(pCols[nCol]) * nCount;
+			anSum[1] += (uint64_t)RLS_PQUANT_G(pCols[nCol]) * nCount;
+			anSum[2] += (uint64_t)RLS_PQUANT_B(pCols[nCol]) * nCount;
+			nPixels += nCount;
+		}
+		pPal[nBox] = (uint16_t)((((anSum[0] + nPixels/2) / nPixels) << 11)
+							  | (((anSum[1] + nPixels/2) / nPixels) << 5)
+							  | ((anSum[2] + nPixels/2) / nPixels));
+	}
+
+	/* k-means refinement */
+	for (nPass = 0; nPass < RLS_PQUANT_KMEANS; nPass++)
+	{
+		uint64_t anSum[RLS_SPAL_SIZE][3];
+		uint32_t anPixels[RLS_SPAL_SIZE];
+		bool bChanged = false;
+
+		RLS_PQuant_MapColors(pCols, nCols, pPal, nBoxes, pMap);
+		memset(anSum, 0, sizeof(anSum));
+		memset(anPixels, 0, sizeof(anPixels));
+		for (nCol = 0; nCol < nCols; nCol++)
+		{
+			uint32_t nCount = pHist[pCols[nCol]];
+			uint8_t nIdx = pMap[pCols[nCol]];
+			anSum[nIdx][0] += (uint64_t)RLS_PQUANT_R(pCols[nCol]) * nCount;
+			anSum[nIdx][1] += (uint64_t)RLS_PQUANT_G(pCols[nCol]) * nCount;
+			anSum[nIdx][2] += (uint64_t)RLS_PQUANT_B(pCols[nCol]) * nCount;
+			anPixels[nIdx] += nCount;
+		}
+		for (nBox = 0; nBox < nBoxes; nBox++)
+		{
+			uint32_t nPixels = anPixels[nBox];
+			uint16_t wColor;
+			if (!nPixels)
+				continue;
+			wColor = (uint16_t)((((anSum[nBox][0]+nPixels/2)/nPixels) << 11)
+							  | (((anSum[nBox][1]+nPixels/2)/nPixels) << 5)
+							  | ((anSum[nBox][2]+nPixels/2)/nPixels));
+			if (wColor != pPal[nBox])
+			{
+				pPal[nBox] = wColor;
+				bChanged = true;
+			}
+		}
+		if (bChanged == false)
+			break;
+	}
+
+	RLS_PQuant_MapColors(pCols, nCols, pPal, nBoxes, pMap);
+	for (nY = 0, pRow = pImg; nY < nHeight; nY++, pRow += nStride)
+		for (nPix = 0; nPix < nWidth; nPix++)
+			pRow[nPix] = pPal[pMap[pRow[nPix]]];
+
+	free(pHist);
+	free(pCols);
+	free(pMap);
+	return nBoxes;
+}
\ No newline at end of file
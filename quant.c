@@ -9,6 +9,8 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Block statistics and apply split out
+** 10/18/2026	agent			Row stride parameters
 ** 12/01/2024	raulmrio28-git	Initial version
 ** ===========================================================================
 */
@@ -49,7 +51,10 @@
 */
 
 #include "convert.h"
+#include "quant.h"
+#include "limits.h"
 #include "math.h"
+#include "stdlib.h"
 #include "string.h"
 
 /*
@@ -141,6 +146,7 @@ typedef struct BlockInfo
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -181,6 +187,7 @@ static uint8_t RLS_Quant_GetChan(uint16_t color, channel_offset chan)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -237,6 +244,7 @@ static void RLS_Quant_GetCols(uint8_t* min, uint8_t* max,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -287,6 +295,7 @@ static int RLS_Quant_GetBkInfo(BlockInfo* bi, int block)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -330,6 +339,7 @@ static uint16_t RLS_Quant_888to565(uint8_t* rgb888)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -368,6 +378,7 @@ static int RLS_Quant_DiffColors(uint8_t* colorA, uint8_t* colorB)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -417,6 +428,7 @@ static int RLS_Quant_MaxCompDiff(uint16_t* colorA, uint16_t* colorB)
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -495,6 +507,7 @@ static void RLS_Quant_GetMaxCompDiff(BlockInfo* bi, uint16_t* block_ptr,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -544,6 +557,7 @@ static int RLS_Quant_CompareBlock(uint16_t* block1, uint16_t* block2,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -629,6 +643,7 @@ static int RLS_Quant_LeastSq(uint16_t* block_ptr, BlockInfo* bi,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -695,6 +710,7 @@ static int RLS_Quant_MaxLsqFitError(uint16_t* block_ptr, BlockInfo* bi,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/21/2020	richardpl       avcodec: add RPZA encoder
 ** ---------------------------------------------------------------------------
@@ -747,6 +763,7 @@ static int RLS_Quant_ApproxColor(uint16_t* color, uint8_t colors[4][3])
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 11/12/2022	richardpl	    avcodec/rpzaenc: stop accessing out of bounds
 **                              frame
@@ -783,30 +800,28 @@ static int RLS_Quant_QuantBlock(uint8_t* min_color, uint8_t* max_color,
 ** ---------------------------------------------------------------------------
 **
 ** Function:
-**     RLS_Quant_UpdStats
+**     RLS_Quant_BlkStats
 **
 ** Description:
-**     Update block stats
+**     Get the average color of a block and how far its pixels are from it
 **
 ** Input:
 **     bi - block info
 **     block - 2x2 block
-**     min_color - minimum color
-**     max_color - maximum color
-**     total_rgb - total rgb
-**     total_pixels - total pixels
 **     avg_color - average color
-**     first_block - first block
+**     spread - spread
 **
 ** Output:
-**     Quantized block
+**     Average color, largest per-channel distance of a pixel from it
 **
 ** Return value:
-**     1
+**     none
 **
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Return the spread instead of a range check
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 11/12/2022	richardpl	    avcodec/rpzaenc: stop accessing out of bounds
 **                              frame
@@ -814,109 +829,223 @@ static int RLS_Quant_QuantBlock(uint8_t* min_color, uint8_t* max_color,
 ** ---------------------------------------------------------------------------
 */
 
-static int RLS_Quant_UpdStats(BlockInfo* bi, uint16_t* block,
-    uint8_t min_color[3], uint8_t max_color[3],
-    int* total_rgb, int* total_pixels,
-    uint8_t avg_color[3], int first_block)
+static void RLS_Quant_BlkStats(BlockInfo* bi, uint16_t* block,
+    uint8_t avg_color[3], int* spread)
 {
-    int x, y;
-    int is_in_range;
-    int total_pixels_blk;
-    int threshold;
-
-    uint8_t min_color_blk[3], max_color_blk[3];
-    int total_rgb_blk[3];
-    uint8_t avg_color_blk[3];
-
-    if (first_block) {
-        min_color[0] = UINT8_MAX;
-        min_color[1] = UINT8_MAX;
-        min_color[2] = UINT8_MAX;
-        max_color[0] = 0;
-        max_color[1] = 0;
-        max_color[2] = 0;
-        total_rgb[0] = 0;
-        total_rgb[1] = 0;
-        total_rgb[2] = 0;
-        *total_pixels = 0;
-        threshold = 16;
-    }
-    else {
-        threshold = 32;
-    }
-
-    /*
-       The *_blk variables will include the current block.
-       Initialize them based on the blocks so far.
-     */
-    min_color_blk[0] = min_color[0];
-    min_color_blk[1] = min_color[1];
-    min_color_blk[2] = min_color[2];
-    max_color_blk[0] = max_color[0];
-    max_color_blk[1] = max_color[1];
-    max_color_blk[2] = max_color[2];
-    total_rgb_blk[0] = total_rgb[0];
-    total_rgb_blk[1] = total_rgb[1];
-    total_rgb_blk[2] = total_rgb[2];
-    total_pixels_blk = *total_pixels + bi->block_height * bi->block_width;
+    int x, y, i;
+    int total_pixels = bi->block_height * bi->block_width;
+    uint8_t min_color[3] = { UINT8_MAX, UINT8_MAX, UINT8_MAX };
+    uint8_t max_color[3] = { 0, 0, 0 };
+    int total_rgb[3] = { 0, 0, 0 };
 
-    /*
-       Update stats for this block's pixels
-     */
     for (y = 0; y < bi->block_height; y++) {
         for (x = 0; x < bi->block_width; x++) {
-            total_rgb_blk[0] += R(block[x]);
-            total_rgb_blk[1] += G(block[x]);
-            total_rgb_blk[2] += B(block[x]);
+            total_rgb[0] += R(block[x]);
+            total_rgb[1] += G(block[x]);
+            total_rgb[2] += B(block[x]);
 
-            min_color_blk[0] = QUANT_MIN(R(block[x]), min_color_blk[0]);
-            min_color_blk[1] = QUANT_MIN(G(block[x]), min_color_blk[1]);
-            min_color_blk[2] = QUANT_MIN(B(block[x]), min_color_blk[2]);
+            min_color[0] = QUANT_MIN(R(block[x]), min_color[0]);
+            min_color[1] = QUANT_MIN(G(block[x]), min_color[1]);
+            min_color[2] = QUANT_MIN(B(block[x]), min_color[2]);
 
-            max_color_blk[0] = QUANT_MAX(R(block[x]), max_color_blk[0]);
-            max_color_blk[1] = QUANT_MAX(G(block[x]), max_color_blk[1]);
-            max_color_blk[2] = QUANT_MAX(B(block[x]), max_color_blk[2]);
+            max_color[0] = QUANT_MAX(R(block[x]), max_color[0]);
+            max_color[1] = QUANT_MAX(G(block[x]), max_color[1]);
+            max_color[2] = QUANT_MAX(B(block[x]), max_color[2]);
         }
         block += bi->rowstride;
     }
 
     /*
-       Calculate average color including current block.
+       The block is one color for every threshold at least this large
      */
-    avg_color_blk[0] = total_rgb_blk[0] / total_pixels_blk;
-    avg_color_blk[1] = total_rgb_blk[1] / total_pixels_blk;
-    avg_color_blk[2] = total_rgb_blk[2] / total_pixels_blk;
+    *spread = 0;
+    for (i = 0; i < 3; i++) {
+        avg_color[i] = total_rgb[i] / total_pixels;
+        *spread = QUANT_MAX(*spread, max_color[i] - avg_color[i]);
+        *spread = QUANT_MAX(*spread, avg_color[i] - min_color[i]);
+    }
+}
 
-    /*
-       Are all the pixels within threshold of the average color?
-     */
-    is_in_range = (max_color_blk[0] - avg_color_blk[0] <= threshold &&
-        max_color_blk[1] - avg_color_blk[1] <= threshold &&
-        max_color_blk[2] - avg_color_blk[2] <= threshold &&
-        avg_color_blk[0] - min_color_blk[0] <= threshold &&
-        avg_color_blk[1] - min_color_blk[1] <= threshold &&
-        avg_color_blk[2] - min_color_blk[2] <= threshold);
-
-    if (is_in_range) {
-        /*
-           Set the output variables to include this block.
-         */
-        min_color[0] = min_color_blk[0];
-        min_color[1] = min_color_blk[1];
-        min_color[2] = min_color_blk[2];
-        max_color[0] = max_color_blk[0];
-        max_color[1] = max_color_blk[1];
-        max_color[2] = max_color_blk[2];
-        total_rgb[0] = total_rgb_blk[0];
-        total_rgb[1] = total_rgb_blk[1];
-        total_rgb[2] = total_rgb_blk[2];
-        *total_pixels = total_pixels_blk;
-        avg_color[0] = avg_color_blk[0];
-        avg_color[1] = avg_color_blk[1];
-        avg_color[2] = avg_color_blk[2];
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quant_AnalyzeBlk
+**
+** Description:
+**     Collect everything the quantizer needs to know about a block
+**
+** Input:
+**     bi - block info
+**     block_ptr - 2x2 block
+**     stats - block statistics
+**     flat_tol - skip the four color fit if the block is one color at this
+**                threshold (-1 - never skip)
+**
+** Output:
+**     Block statistics
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Split out of RLS_Quantize
+** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
+** 08/21/2020	richardpl       avcodec: add RPZA encoder
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Quant_AnalyzeBlk(BlockInfo* bi, uint16_t* block_ptr,
+    RLSQuantBlk_T* stats, int flat_tol)
+{
+    uint8_t min = 0, max = 0;
+    channel_offset chan;
+    int i;
+    int tmp_min, tmp_max;
+    int err = 0;
+    double slope, y_intercept, correlation_coef;
+
+    // ONE COLOR CHECK
+    RLS_Quant_BlkStats(bi, block_ptr, stats->abAvg, &stats->nSpread);
+    stats->nFitErr = INT_MAX;
+    if (stats->nSpread <= flat_tol)
+        return;
+
+    // FOUR COLOR CHECK
+    // get max component diff for block
+    RLS_Quant_GetMaxCompDiff(bi, block_ptr, &min, &max, &chan);
+
+    // run least squares against other two components
+    for (i = 0; i < 3; i++) {
+        if (i == chan) {
+            stats->abMin[i] = min;
+            stats->abMax[i] = max;
+            continue;
+        }
+
+        slope = y_intercept = correlation_coef = 0;
+
+        if (RLS_Quant_LeastSq(block_ptr, bi, chan, i,
+            &slope, &y_intercept, &correlation_coef)) {
+            stats->abMin[i] = RLS_Quant_GetChan(block_ptr[0], i);
+            stats->abMax[i] = RLS_Quant_GetChan(block_ptr[0], i);
+        }
+        else {
+            tmp_min = (int)(min * slope + y_intercept);
+            tmp_max = (int)(max * slope + y_intercept);
+
+            // clamp min and max color values
+            tmp_min = QUANT_CLIP(tmp_min);
+            tmp_max = QUANT_CLIP(tmp_max);
+
+            err = QUANT_MAX(RLS_Quant_MaxLsqFitError(block_ptr, bi,
+                min, max, tmp_min, tmp_max, chan, i), err);
+
+            stats->abMin[i] = tmp_min;
+            stats->abMax[i] = tmp_max;
+        }
+    }
+    stats->nFitErr = err;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quant_ApplyBlk
+**
+** Description:
+**     Quantize a block from its statistics
+**
+** Input:
+**     bi - block info
+**     block_ptr - 2x2 block
+**     stats - block statistics
+**     flat_tol - one color threshold
+**     fit_tol - four color fit error limit
+**
+** Output:
+**     Quantized block
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Split out of RLS_Quantize
+** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
+** 08/21/2020	richardpl       avcodec: add RPZA encoder
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Quant_ApplyBlk(BlockInfo* bi, uint16_t* block_ptr,
+    const RLSQuantBlk_T* stats, int flat_tol, int fit_tol)
+{
+    if (stats->nSpread <= flat_tol) { // ONE COLOR BLOCK
+        uint8_t avg_color[3];
+        int y_size, x_size, rgb555;
+
+        memcpy(avg_color, stats->abAvg, sizeof(avg_color));
+        rgb555 = RLS_Quant_888to565(avg_color);
+        y_size = QUANT_MIN(2, bi->image_height - bi->row * 2);
+        x_size = QUANT_MIN(2, bi->image_width - bi->col * 2);
+
+        for (int y = 0; y < y_size; y++) {
+            for (int x = 0; x < x_size; x++) {
+                block_ptr[x] = rgb555;
+            }
+
+            block_ptr += bi->rowstride;
+        }
     }
+    else if (stats->nFitErr <= fit_tol) { // FOUR COLOR BLOCK
+        uint8_t min_color[3], max_color[3];
 
-    return is_in_range;
+        memcpy(min_color, stats->abMin, sizeof(min_color));
+        memcpy(max_color, stats->abMax, sizeof(max_color));
+        RLS_Quant_QuantBlock(min_color, max_color, block_ptr, bi);
+    }
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quant_InitBkInfo
+**
+** Description:
+**     Set up block info for a whole image
+**
+** Input:
+**     bi - block info
+**     nWidth - Width of image
+**     nHeight - Height of image
+**     nStride - Row stride of image in pixels
+**
+** Output:
+**     Block info
+**
+** Return value:
+**     Number of 2x2 blocks in the image
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Split out of RLS_Quantize
+** ---------------------------------------------------------------------------
+*/
+
+static int RLS_Quant_InitBkInfo(BlockInfo* bi, int nWidth, int nHeight,
+    int nStride)
+{
+    bi->image_width = nWidth;
+    bi->image_height = nHeight;
+    bi->rowstride = nStride;
+    bi->blocks_per_row = (nWidth + 1) / 2;
+    return ((nWidth + 1) / 2) * ((nHeight + 1) / 2);
 }
 
 /*
@@ -932,6 +1061,7 @@ static int RLS_Quant_UpdStats(BlockInfo* bi, uint16_t* block,
 **     pImg: Image to quantize
 **     nWidth: Width of image
 **     nHeight: Height of image
+**     nStride: Row stride of image in pixels
 **
 ** Output:
 **     Quantized image
@@ -942,6 +1072,8 @@ static int RLS_Quant_UpdStats(BlockInfo* bi, uint16_t* block,
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Block statistics and apply split out
+** 10/18/2026	agent			Row stride
 ** 12/01/2024	raulmrio28-git  Adapt to RLS encoder
 ** 08/13/2024	jamrial 	    avcodec/rpzaenc: don't use buffer data beyond
 **                              the end of a row
@@ -953,110 +1085,130 @@ static int RLS_Quant_UpdStats(BlockInfo* bi, uint16_t* block,
 ** ---------------------------------------------------------------------------
 */
 
-void RLS_Quantize(RGB565_T* pImg, int nWidth, int nHeight)
+void RLS_Quantize(RGB565_T* pImg, int nWidth, int nHeight, int nStride)
 {
     BlockInfo bi;
-    int block_counter = 0;
+    RLSQuantBlk_T stats;
+    int block_counter;
     int total_blocks;
-    int block_offset = 0;
-    uint8_t min = 0, max = 0;
-    channel_offset chan;
-    int i;
-    int tmp_min, tmp_max;
-    int total_rgb[3];
-    uint8_t avg_color[3];
-    int pixel_count;
-    uint8_t min_color[3], max_color[3];
-    double slope, y_intercept, correlation_coef;
-    uint16_t* src_pixels = (uint16_t*)pImg;
+    int block_offset;
 
-    /* Number of 2x2 blocks in frame. */
-    total_blocks = ((nWidth + 1) / 2) * ((nHeight + 1) / 2);
+    if (!pImg || nWidth <= 0 || nHeight <= 0 || nStride < nWidth)
+        return;
 
-    bi.image_width = nWidth;
-    bi.image_height = nHeight;
-    bi.rowstride = nWidth;
+    total_blocks = RLS_Quant_InitBkInfo(&bi, nWidth, nHeight, nStride);
+    for (block_counter = 0; block_counter < total_blocks; block_counter++) {
+        block_offset = RLS_Quant_GetBkInfo(&bi, block_counter);
+        RLS_Quant_AnalyzeBlk(&bi, &pImg[block_offset], &stats,
+            RLS_QUANT_FLAT_TOL);
+        RLS_Quant_ApplyBlk(&bi, &pImg[block_offset], &stats,
+            RLS_QUANT_FLAT_TOL, RLS_QUANT_FIT_TOL);
+    }
+}
 
-    bi.blocks_per_row = (nWidth + 1) / 2;
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quantize_Analyze
+**
+** Description:
+**     Collect the statistics of every block once, so the image can be
+**     quantized at several tolerances with RLS_Quantize_Apply without
+**     repeating the least squares fits
+**
+** Input:
+**     pImg: Image to analyze
+**     nWidth: Width of image
+**     nHeight: Height of image
+**     nStride: Row stride of image in pixels
+**
+** Output:
+**     none
+**
+** Return value:
+**     Block statistics (free() them when done)/NULL
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+RLSQuantBlk_T* RLS_Quantize_Analyze(const RGB565_T* pImg, int nWidth,
+                                    int nHeight, int nStride)
+{
+    BlockInfo bi;
+    RLSQuantBlk_T* stats;
+    int block_counter;
+    int total_blocks;
+    int block_offset;
 
-    while (block_counter < total_blocks) {
+    if (!pImg || nWidth <= 0 || nHeight <= 0 || nStride < nWidth)
+        return NULL;
+
+    total_blocks = RLS_Quant_InitBkInfo(&bi, nWidth, nHeight, nStride);
+    stats = (RLSQuantBlk_T*)malloc(total_blocks * sizeof(RLSQuantBlk_T));
+    if (!stats)
+        return NULL;
+    for (block_counter = 0; block_counter < total_blocks; block_counter++) {
         block_offset = RLS_Quant_GetBkInfo(&bi, block_counter);
-        // ONE COLOR CHECK
-        if (RLS_Quant_UpdStats(&bi, &src_pixels[block_offset],
-            min_color, max_color,
-            total_rgb, &pixel_count, avg_color, 1)) {
-                {
-                    uint16_t* row_ptr;
-                    int y_size, x_size, rgb555;
-
-                    block_offset = RLS_Quant_GetBkInfo(&bi, block_counter);
-
-                    row_ptr = &src_pixels[block_offset];
-                    y_size = QUANT_MIN(2, bi.image_height - bi.row * 2);
-                    x_size = QUANT_MIN(2, bi.image_width - bi.col * 2);
-
-                    for (int y = 0; y < y_size; y++) {
-                        for (int x = 0; x < x_size; x++) {
-                            rgb555 = RLS_Quant_888to565(avg_color);
-                            row_ptr[x] = rgb555;
-                        }
-
-                        row_ptr += bi.rowstride;
-                    }
-                }
-                block_counter++;
-        }
-        else { // FOUR COLOR CHECK
-            int err = 0;
-
-            // get max component diff for block
-            RLS_Quant_GetMaxCompDiff(&bi, &src_pixels[block_offset], &min,
-                &max, &chan);
-
-            min_color[0] = 0;
-            max_color[0] = 0;
-            min_color[1] = 0;
-            max_color[1] = 0;
-            min_color[2] = 0;
-            max_color[2] = 0;
-
-            // run least squares against other two components
-            for (i = 0; i < 3; i++) {
-                if (i == chan) {
-                    min_color[i] = min;
-                    max_color[i] = max;
-                    continue;
-                }
-
-                slope = y_intercept = correlation_coef = 0;
-
-                if (RLS_Quant_LeastSq(&src_pixels[block_offset], &bi, chan, i,
-                    &slope, &y_intercept, &correlation_coef)) {
-                    min_color[i] = RLS_Quant_GetChan(src_pixels[block_offset],
-                        i);
-                    max_color[i] = RLS_Quant_GetChan(src_pixels[block_offset],
-                        i);
-                }
-                else {
-                    tmp_min = (int)(min * slope + y_intercept);
-                    tmp_max = (int)(max * slope + y_intercept);
-
-                    // clamp min and max color values
-                    tmp_min = QUANT_CLIP(tmp_min);
-                    tmp_max = QUANT_CLIP(tmp_max);
-
-                    err = QUANT_MAX(RLS_Quant_MaxLsqFitError
-                    (&src_pixels[block_offset], &bi,
-                        min, max, tmp_min, tmp_max, chan, i), err);
-
-                    min_color[i] = tmp_min;
-                    max_color[i] = tmp_max;
-                }
-            }
-            if (err <= 8) // FOUR COLOR BLOCK
-                RLS_Quant_QuantBlock(min_color, max_color,
-                    &src_pixels[block_offset], &bi);
-            block_counter++;
-        }
+        RLS_Quant_AnalyzeBlk(&bi, (uint16_t*)&pImg[block_offset],
+            &stats[block_counter], -1);
+    }
+    return stats;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Quantize_Apply
+**
+** Description:
+**     Quantize the image RLS_Quantize_Analyze looked at. Larger tolerances
+**     turn more blocks into one or four colors; the defaults match
+**     RLS_Quantize.
+**
+** Input:
+**     pStats: Block statistics
+**     pImg: Image to quantize, a copy of the analyzed one
+**     nWidth: Width of image
+**     nHeight: Height of image
+**     nStride: Row stride of image in pixels
+**     nFlatTol: One color threshold (RLS_QUANT_FLAT_TOL)
+**     nFitTol: Four color fit error limit (RLS_QUANT_FIT_TOL)
+**
+** Output:
+**     Quantized image
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Quantize_Apply(const RLSQuantBlk_T* pStats, RGB565_T* pImg,
+                        int nWidth, int nHeight, int nStride, int nFlatTol,
+                        int nFitTol)
+{
+    BlockInfo bi;
+    int block_counter;
+    int total_blocks;
+    int block_offset;
+
+    if (!pStats || !pImg || nWidth <= 0 || nHeight <= 0 || nStride < nWidth)
+        return;
+
+    total_blocks = RLS_Quant_InitBkInfo(&bi, nWidth, nHeight, nStride);
+    for (block_counter = 0; block_counter < total_blocks; block_counter++) {
+        block_offset = RLS_Quant_GetBkInfo(&bi, block_counter);
+        RLS_Quant_ApplyBlk(&bi, &pImg[block_offset], &pStats[block_counter],
+            nFlatTol, nFitTol);
     }
 }
\ No newline at end of file
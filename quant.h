@@ -0,0 +1,88 @@
+/*
+** ===========================================================================
+** File: quant.h
+** Description: ReakoLite library encoder quantizer header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Block statistics and apply split out
+** 10/18/2026	agent			Row stride parameters
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_QUANT_H
+#define RLS_QUANT_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "convert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_QUANT_FLAT_TOL 16 /* RLS_Quantize one color threshold */
+#define RLS_QUANT_FIT_TOL 8 /* RLS_Quantize four color fit error limit */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSQuantBlk_T RLSQuantBlk_T;
+
+/* what RLS_Quantize_Analyze learned about one 2x2 block */
+typedef struct tagRLSQuantBlk_T
+{
+	uint8_t abAvg[3]; /* one color candidate */
+	int nSpread; /* largest distance of a pixel from abAvg */
+	uint8_t abMin[3]; /* four color candidate end points */
+	uint8_t abMax[3];
+	int nFitErr; /* four color fit error, INT_MAX if not fitted */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern void RLS_Quantize(RGB565_T* pImg, int nWidth, int nHeight,
+						 int nStride);
+extern RLSQuantBlk_T* RLS_Quantize_Analyze(const RGB565_T* pImg, int nWidth,
+										   int nHeight, int nStride);
+extern void RLS_Quantize_Apply(const RLSQuantBlk_T* pStats, RGB565_T* pImg,
+							   int nWidth, int nHeight, int nStride,
+							   int nFlatTol, int nFitTol);
+extern int RLS_Quantize_Palette(RGB565_T* pImg, int nWidth, int nHeight,
+								int nStride, uint16_t* pPal, int nMaxCols);
+extern int RLS_Quantize_Blocks(RGB565_T* pImg, int nWidth, int nHeight,
+							   int nStride, int nTolerance,
+							   const uint16_t* pPal, int nPalCols);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_QUANT_H
\ No newline at end of file
@@ -0,0 +1,389 @@
+/*
+** ===========================================================================
+** File: scan.c
+** Description: ReakoLite library embedded image scanner code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "common.h"
+#include "convert.h"
+#include "export.h"
+#include "scan.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef RLS_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_SCAN_MAGIC_LO (RLS_MAGIC & 0xFF) /* 'R' */
+#define RLS_SCAN_MAGIC_HI (RLS_MAGIC >> 8) /* 'L' */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSScanJob_T RLSScanJob_T;
+
+typedef struct tagRLSScanJob_T
+{
+	const uint8_t* pData;
+	RLSScanHit_T* ptHits;
+	int nHits;
+	const char* pszDir;
+	RLS_Mutex_T tMutex;
+	int nNext; /* next hit for a worker */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Scan_NextMagic
+**
+** Description:
+**     Finds the next RLS_MAGIC byte pair, 16 positions per step with SSE2
+**
+** Input:
+**     pData - Blob
+**     nSize - Blob size
+**     nPos - Position to search from
+**
+** Output:
+**     none
+**
+** Return value:
+**     Position of the pair/nSize (none left)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static size_t RLS_Scan_NextMagic(const uint8_t* pData, size_t nSize,
+								 size_t nPos)
+{
+#ifdef RLS_HAVE_SSE2
+	const __m128i tLo = _mm_set1_epi8(RLS_SCAN_MAGIC_LO);
+	const __m128i tHi = _mm_set1_epi8(RLS_SCAN_MAGIC_HI);
+	/* the second load reads one byte further */
+	while (nSize > 16 && nPos < nSize - 16)
+	{
+		__m128i tA = _mm_loadu_si128((const __m128i*)(pData + nPos));
+		__m128i tB = _mm_loadu_si128((const __m128i*)(pData + nPos + 1));
+		int nMask = _mm_movemask_epi8(_mm_and_si128(
+						_mm_cmpeq_epi8(tA, tLo), _mm_cmpeq_epi8(tB, tHi)));
+		if (nMask)
+		{
+			while (!(nMask & 1))
+			{
+				nMask >>= 1;
+				nPos++;
+			}
+			return nPos;
+		}
+		nPos += 16;
+	}
+#endif
+	for (; nPos + 1 < nSize; nPos++)
+		if (pData[nPos] == RLS_SCAN_MAGIC_LO
+		 && pData[nPos + 1] == RLS_SCAN_MAGIC_HI)
+			return nPos;
+	return nSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Scan_ExtractHit
+**
+** Description:
+**     Writes an image found in a blob to <dir>/<offset>.rls and its frames
+**     to <dir>/<offset>_<frame>.png, offset in hex
+**
+** Input:
+**     pData - Blob
+**     ptHit - Image
+**     pszDir - Output directory
+**
+** Output:
+**     Files, result in the hit
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Scan_ExtractHit(const uint8_t* pData, RLSScanHit_T* ptHit,
+								const char* pszDir)
+{
+	char* pszFn = (char*)malloc(strlen(pszDir) + 32);
+	FILE* pFile;
+
+	ptHit->nFailed = 0;
+	if (!pszFn)
+	{
+		ptHit->nResult = RLS_EXPORT_EMEM;
+		return;
+	}
+	sprintf(pszFn, "%s/%08llX.rls", pszDir,
+			(unsigned long long)ptHit->nOffset);
+	pFile = fopen(pszFn, "wb");
+	ptHit->nResult = RLS_EXPORT_EWRITE;
+	if (pFile)
+	{
+		if (fwrite(pData + ptHit->nOffset, 1, ptHit->nSize, pFile)
+			== ptHit->nSize)
+			ptHit->nResult = RLS_EXPORT_OK;
+		if (fclose(pFile) != 0)
+			ptHit->nResult = RLS_EXPORT_EWRITE;
+	}
+	if (ptHit->nResult == RLS_EXPORT_OK)
+	{
+		/* drop ".rls", the frames are named after the same base */
+		pszFn[strlen(pszFn) - 4] = '\0';
+		ptHit->nResult = RLS_Export_PNGs((uint8_t*)pData + ptHit->nOffset,
+										 ptHit->nSize, pszFn, 1,
+										 &ptHit->nFailed);
+	}
+	free(pszFn);
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Scan_Worker
+**
+** Description:
+**     Extracts hits until none are left
+**
+** Input:
+**     pArg - Pointer to the scan job
+**
+** Output:
+**     Files, results in the hits
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+static void RLS_Scan_Worker(void* pArg)
+{
+	RLSScanJob_T* ptJob = *(RLSScanJob_T**)pArg;
+	for (;;)
+	{
+		int nHit;
+		RLS_Mutex_Lock(&ptJob->tMutex);
+		nHit = ptJob->nNext++;
+		RLS_Mutex_Unlock(&ptJob->tMutex);
+		if (nHit >= ptJob->nHits)
+			break;
+		RLS_Scan_ExtractHit(ptJob->pData, &ptJob->ptHits[nHit],
+							ptJob->pszDir);
+	}
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Scan_Find
+**
+** Description:
+**     Finds every RLS image embedded in a blob. Each magic candidate is
+**     checked with RLS_Common_GetSize, and the search goes on after the
+**     end of every image found.
+**
+** Input:
+**     pData - Blob
+**     nSize - Blob size
+**     pptHits - Hit array pointer, free() it when done
+**
+** Output:
+**     Hit array
+**
+** Return value:
+**     Hit count/-1 (out of memory)
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Scan_Find(const uint8_t* pData, size_t nSize,
+				  RLSScanHit_T** pptHits)
+{
+	RLSScanHit_T* ptHits = NULL;
+	int nHits = 0, nMaxHits = 0;
+	size_t nPos = 0;
+
+	*pptHits = NULL;
+	if (!pData)
+		return 0;
+	while ((nPos = RLS_Scan_NextMagic(pData, nSize, nPos)) < nSize)
+	{
+		RLSScanHit_T* ptHit;
+		size_t nHitSize = RLS_Common_GetSize(pData + nPos, nSize - nPos);
+		if (!nHitSize)
+		{
+			nPos++;
+			continue;
+		}
+		if (nHits == nMaxHits)
+		{
+			RLSScanHit_T* ptGrown;
+			nMaxHits = nMaxHits ? nMaxHits * 2 : 64;
+			ptGrown = (RLSScanHit_T*)realloc(ptHits,
+											 nMaxHits * sizeof(RLSScanHit_T));
+			if (!ptGrown)
+			{
+				free(ptHits);
+				return -1;
+			}
+			ptHits = ptGrown;
+		}
+		ptHit = &ptHits[nHits++];
+		memset(ptHit, 0, sizeof(RLSScanHit_T));
+		ptHit->nOffset = nPos;
+		ptHit->nSize = nHitSize;
+		RLS_Common_GetInfo((uint8_t*)pData + nPos, &ptHit->nFrames,
+						   &ptHit->nWidth, &ptHit->nHeight, NULL);
+		nPos += nHitSize;
+	}
+	*pptHits = ptHits;
+	return nHits;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Scan_Extract
+**
+** Description:
+**     Extracts hits of RLS_Scan_Find into a directory, several hits at
+**     once. See RLS_Scan_ExtractHit for the file names.
+**
+** Input:
+**     pData - Blob
+**     ptHits - Hits
+**     nHits - Hit count
+**     pszDir - Output directory, must exist
+**     nWorkers - Threads (1 - extract on the calling thread)
+**
+** Output:
+**     Files, result of every hit
+**
+** Return value:
+**     Hits extracted without errors
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Scan_Extract(const uint8_t* pData, RLSScanHit_T* ptHits,
+					 int nHits, const char* pszDir, int nWorkers)
+{
+	RLSScanJob_T tJob;
+	RLSScanJob_T* aptJobs[RLS_THREAD_MAX];
+	RGB565_T wPix = 0;
+	RGB888_T tPix;
+	int nHit, nExtracted = 0;
+
+	if (!pData || !ptHits || nHits <= 0 || !pszDir)
+		return 0;
+	tJob.pData = pData;
+	tJob.ptHits = ptHits;
+	tJob.nHits = nHits;
+	tJob.pszDir = pszDir;
+	tJob.nNext = 0;
+	if (nWorkers > nHits)
+		nWorkers = nHits;
+	if (nWorkers > RLS_THREAD_MAX)
+		nWorkers = RLS_THREAD_MAX;
+	if (nWorkers > 1 && !RLS_Mutex_Init(&tJob.tMutex))
+		nWorkers = 1;
+	/* pick the conversion kernels before the workers race to do it */
+	RLS_Convert_565to888(&wPix, &tPix, 1, 1);
+	for (nHit = 0; nHit < nWorkers; nHit++)
+		aptJobs[nHit] = &tJob;
+	if (nWorkers > 1)
+	{
+		RLS_Thread_Run(RLS_Scan_Worker, aptJobs, sizeof(aptJobs[0]),
+					   nWorkers);
+		RLS_Mutex_Destroy(&tJob.tMutex);
+	}
+	else
+	{
+		for (nHit = 0; nHit < nHits; nHit++)
+			RLS_Scan_ExtractHit(pData, &ptHits[nHit], pszDir);
+	}
+	for (nHit = 0; nHit < nHits; nHit++)
+		if (ptHits[nHit].nResult == RLS_EXPORT_OK)
+			nExtracted++;
+	return nExtracted;
+}
\ No newline at end of file
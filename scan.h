@@ -0,0 +1,76 @@
+/*
+** ===========================================================================
+** File: scan.h
+** Description: ReakoLite library embedded image scanner header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_SCAN_H
+#define RLS_SCAN_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSScanHit_T RLSScanHit_T;
+
+typedef struct tagRLSScanHit_T
+{
+	size_t nOffset; /* from the start of the blob */
+	size_t nSize; /* container size, frame index included */
+	int nFrames;
+	int nWidth;
+	int nHeight;
+	int nResult; /* RLS_EXPORT_* once extracted */
+	int nFailed; /* failed frame */
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern int RLS_Scan_Find(const uint8_t* pData, size_t nSize,
+						 RLSScanHit_T** pptHits);
+extern int RLS_Scan_Extract(const uint8_t* pData, RLSScanHit_T* ptHits,
+							int nHits, const char* pszDir, int nWorkers);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_SCAN_H
\ No newline at end of file
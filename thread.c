@@ -0,0 +1,676 @@
+/*
+** ===========================================================================
+** File: thread.c
+** Description: ReakoLite library threading code
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Time stamps and sleep
+** 10/18/2026	agent			Mutexes and condition variables
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "thread.h"
+#include <stdlib.h>
+#ifndef _WIN32
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct tagRLSThreadStart_T RLSThreadStart_T;
+
+typedef struct tagRLSThreadStart_T
+{
+	RLS_ThreadFn_T pfnFunc;
+	void* pArg;
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Global variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_Start
+**
+** Description:
+**     Native thread entry, calls the user function
+**
+** Input:
+**     pArg - Start information (freed here)
+**
+** Output:
+**     none
+**
+** Return value:
+**     0
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+#ifdef _WIN32
+static DWORD WINAPI RLS_Thread_Start(LPVOID pArg)
+#else
+static void* RLS_Thread_Start(void* pArg)
+#endif
+{
+	RLSThreadStart_T tStart = *(RLSThreadStart_T*)pArg;
+	free(pArg);
+	tStart.pfnFunc(tStart.pArg);
+	return 0;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_Create
+**
+** Description:
+**     Starts a thread
+**
+** Input:
+**     ptThread - Thread handle pointer
+**     pfnFunc - Thread function
+**     pArg - Thread function argument
+**
+** Output:
+**     Thread handle
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Thread_Create(RLS_Thread_T* ptThread, RLS_ThreadFn_T pfnFunc,
+					   void* pArg)
+{
+	RLSThreadStart_T* ptStart;
+	if (!ptThread || !pfnFunc)
+		return false;
+	ptStart = (RLSThreadStart_T*)malloc(sizeof(RLSThreadStart_T));
+	if (!ptStart)
+		return false;
+	ptStart->pfnFunc = pfnFunc;
+	ptStart->pArg = pArg;
+#ifdef _WIN32
+	*ptThread = CreateThread(NULL, 0, RLS_Thread_Start, ptStart, 0, NULL);
+	if (*ptThread == NULL)
+#else
+	if (pthread_create(ptThread, NULL, RLS_Thread_Start, ptStart) != 0)
+#endif
+	{
+		free(ptStart);
+		return false;
+	}
+	return true;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_Join
+**
+** Description:
+**     Waits for a thread to finish and releases it
+**
+** Input:
+**     tThread - Thread handle
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Thread_Join(RLS_Thread_T tThread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(tThread, INFINITE);
+	CloseHandle(tThread);
+#else
+	pthread_join(tThread, NULL);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_GetCPUs
+**
+** Description:
+**     Gets count of logical processors
+**
+** Input:
+**     none
+**
+** Output:
+**     none
+**
+** Return value:
+**     1..RLS_THREAD_MAX
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+int RLS_Thread_GetCPUs(void)
+{
+	int nCPUs;
+#ifdef _WIN32
+	SYSTEM_INFO tInfo;
+	GetSystemInfo(&tInfo);
+	nCPUs = (int)tInfo.dwNumberOfProcessors;
+#else
+	nCPUs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (nCPUs < 1)
+		return 1;
+	if (nCPUs > RLS_THREAD_MAX)
+		return RLS_THREAD_MAX;
+	return nCPUs;
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_GetTime
+**
+** Description:
+**     Gets a monotonic time stamp
+**
+** Input:
+**     none
+**
+** Output:
+**     none
+**
+** Return value:
+**     Microseconds from an arbitrary start
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+uint64_t RLS_Thread_GetTime(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER tFreq, tCount;
+	QueryPerformanceFrequency(&tFreq);
+	QueryPerformanceCounter(&tCount);
+	/* split up so the multiplication does not overflow */
+	return (uint64_t)(tCount.QuadPart / tFreq.QuadPart) * 1000000
+		 + (uint64_t)(tCount.QuadPart % tFreq.QuadPart) * 1000000
+		 / tFreq.QuadPart;
+#else
+	struct timespec tNow;
+	clock_gettime(CLOCK_MONOTONIC, &tNow);
+	return (uint64_t)tNow.tv_sec * 1000000 + tNow.tv_nsec / 1000;
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_Sleep
+**
+** Description:
+**     Suspends the calling thread (millisecond granularity on Windows)
+**
+** Input:
+**     nMicros - Time to sleep in microseconds
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Thread_Sleep(uint32_t nMicros)
+{
+#ifdef _WIN32
+	Sleep(nMicros / 1000);
+#else
+	struct timespec tWait;
+	tWait.tv_sec = nMicros / 1000000;
+	tWait.tv_nsec = (long)(nMicros % 1000000) * 1000;
+	nanosleep(&tWait, NULL);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Thread_Run
+**
+** Description:
+**     Runs a function over an array of arguments, one thread per argument,
+**     and waits for all of them. The first argument runs on the caller.
+**
+** Input:
+**     pfnFunc - Thread function
+**     pArgs - Argument array
+**     nArgSize - Size of one argument
+**     nThreads - Argument count
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Thread_Run(RLS_ThreadFn_T pfnFunc, void* pArgs, int nArgSize,
+					int nThreads)
+{
+	RLS_Thread_T atThreads[RLS_THREAD_MAX];
+	bool abStarted[RLS_THREAD_MAX];
+	uint8_t* pArg = (uint8_t*)pArgs;
+	int nThread;
+
+	if (nThreads > RLS_THREAD_MAX)
+		nThreads = RLS_THREAD_MAX;
+	for (nThread = 1; nThread < nThreads; nThread++)
+		abStarted[nThread] = RLS_Thread_Create(&atThreads[nThread], pfnFunc,
+											   pArg + nThread * nArgSize);
+	if (nThreads > 0)
+		pfnFunc(pArg);
+	for (nThread = 1; nThread < nThreads; nThread++)
+	{
+		if (abStarted[nThread])
+			RLS_Thread_Join(atThreads[nThread]);
+		else /* could not start it, do the work here instead */
+			pfnFunc(pArg + nThread * nArgSize);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Mutex_Init
+**
+** Description:
+**     Creates a mutex
+**
+** Input:
+**     ptMutex - Mutex
+**
+** Output:
+**     Mutex
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Mutex_Init(RLS_Mutex_T* ptMutex)
+{
+#ifdef _WIN32
+	InitializeCriticalSection(ptMutex);
+	return true;
+#else
+	return pthread_mutex_init(ptMutex, NULL) == 0;
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Mutex_Lock
+**
+** Description:
+**     Locks a mutex
+**
+** Input:
+**     ptMutex - Mutex
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Mutex_Lock(RLS_Mutex_T* ptMutex)
+{
+#ifdef _WIN32
+	EnterCriticalSection(ptMutex);
+#else
+	pthread_mutex_lock(ptMutex);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Mutex_Unlock
+**
+** Description:
+**     Unlocks a mutex
+**
+** Input:
+**     ptMutex - Mutex
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Mutex_Unlock(RLS_Mutex_T* ptMutex)
+{
+#ifdef _WIN32
+	LeaveCriticalSection(ptMutex);
+#else
+	pthread_mutex_unlock(ptMutex);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Mutex_Destroy
+**
+** Description:
+**     Releases a mutex
+**
+** Input:
+**     ptMutex - Mutex
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Mutex_Destroy(RLS_Mutex_T* ptMutex)
+{
+#ifdef _WIN32
+	DeleteCriticalSection(ptMutex);
+#else
+	pthread_mutex_destroy(ptMutex);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cond_Init
+**
+** Description:
+**     Creates a condition variable
+**
+** Input:
+**     ptCond - Condition variable
+**
+** Output:
+**     Condition variable
+**
+** Return value:
+**     true/false
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+bool RLS_Cond_Init(RLS_Cond_T* ptCond)
+{
+#ifdef _WIN32
+	InitializeConditionVariable(ptCond);
+	return true;
+#else
+	return pthread_cond_init(ptCond, NULL) == 0;
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cond_Wait
+**
+** Description:
+**     Unlocks the mutex, waits for a signal and locks it again
+**
+** Input:
+**     ptCond - Condition variable
+**     ptMutex - Locked mutex
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cond_Wait(RLS_Cond_T* ptCond, RLS_Mutex_T* ptMutex)
+{
+#ifdef _WIN32
+	SleepConditionVariableCS(ptCond, ptMutex, INFINITE);
+#else
+	pthread_cond_wait(ptCond, ptMutex);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cond_Signal
+**
+** Description:
+**     Wakes one thread waiting on a condition variable
+**
+** Input:
+**     ptCond - Condition variable
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cond_Signal(RLS_Cond_T* ptCond)
+{
+#ifdef _WIN32
+	WakeConditionVariable(ptCond);
+#else
+	pthread_cond_signal(ptCond);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cond_Broadcast
+**
+** Description:
+**     Wakes every thread waiting on a condition variable
+**
+** Input:
+**     ptCond - Condition variable
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cond_Broadcast(RLS_Cond_T* ptCond)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(ptCond);
+#else
+	pthread_cond_broadcast(ptCond);
+#endif
+}
+
+/*
+** ---------------------------------------------------------------------------
+**
+** Function:
+**     RLS_Cond_Destroy
+**
+** Description:
+**     Releases a condition variable
+**
+** Input:
+**     ptCond - Condition variable
+**
+** Output:
+**     none
+**
+** Return value:
+**     none
+**
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Initial version
+** ---------------------------------------------------------------------------
+*/
+
+void RLS_Cond_Destroy(RLS_Cond_T* ptCond)
+{
+#ifdef _WIN32
+	(void)ptCond; /* nothing to release */
+#else
+	pthread_cond_destroy(ptCond);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+** ===========================================================================
+** File: thread.h
+** Description: ReakoLite library threading header
+** Copyright (c) 2024 raulmrio28-git.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	agent			Time stamps and sleep
+** 10/18/2026	agent			Mutexes and condition variables
+** 10/18/2026	agent			Initial version
+** ===========================================================================
+*/
+
+#ifndef RLS_THREAD_H
+#define RLS_THREAD_H
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define RLS_THREAD_MAX 64
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+#ifdef _WIN32
+typedef HANDLE RLS_Thread_T;
+typedef CRITICAL_SECTION RLS_Mutex_T;
+typedef CONDITION_VARIABLE RLS_Cond_T;
+#else
+typedef pthread_t RLS_Thread_T;
+typedef pthread_mutex_t RLS_Mutex_T;
+typedef pthread_cond_t RLS_Cond_T;
+#endif
+
+typedef void (*RLS_ThreadFn_T)(void* pArg);
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern bool RLS_Thread_Create(RLS_Thread_T* ptThread, RLS_ThreadFn_T pfnFunc,
+							  void* pArg);
+extern void RLS_Thread_Join(RLS_Thread_T tThread);
+extern int RLS_Thread_GetCPUs(void);
+extern uint64_t RLS_Thread_GetTime(void);
+extern void RLS_Thread_Sleep(uint32_t nMicros);
+extern void RLS_Thread_Run(RLS_ThreadFn_T pfnFunc, void* pArgs,
+						   int nArgSize, int nThreads);
+extern bool RLS_Mutex_Init(RLS_Mutex_T* ptMutex);
+extern void RLS_Mutex_Lock(RLS_Mutex_T* ptMutex);
+extern void RLS_Mutex_Unlock(RLS_Mutex_T* ptMutex);
+extern void RLS_Mutex_Destroy(RLS_Mutex_T* ptMutex);
+extern bool RLS_Cond_Init(RLS_Cond_T* ptCond);
+extern void RLS_Cond_Wait(RLS_Cond_T* ptCond, RLS_Mutex_T* ptMutex);
+extern void RLS_Cond_Signal(RLS_Cond_T* ptCond);
+extern void RLS_Cond_Broadcast(RLS_Cond_T* ptCond);
+extern void RLS_Cond_Destroy(RLS_Cond_T* ptCond);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // RLS_THREAD_H
\ No newline at end of file